@@ -34,13 +34,26 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/OptimiserProfile.h>
+
 #include <json/json.h>
 
+#include <boost/container_hash/hash.hpp>
+
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view/enumerate.hpp>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <fstream>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
@@ -48,6 +61,147 @@ using namespace solidity::evmasm;
 using namespace solidity::langutil;
 using namespace solidity::util;
 
+namespace
+{
+
+/// Threads that are kept alive between calls, so that their thread-local state, e.g. the
+/// simplification rules of the common subexpression eliminator, is only built once.
+class WorkerPool
+{
+public:
+	static WorkerPool& instance()
+	{
+		static WorkerPool pool;
+		return pool;
+	}
+
+	/// Runs @a _job on a worker as soon as one is idle, starting workers until there are at least
+	/// @a _workerCount of them. The job might never run if no worker can be started.
+	void submit(function<void()> _job, size_t _workerCount)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_jobs.push_back(std::move(_job));
+		while (m_workers.size() < _workerCount)
+			try
+			{
+				m_workers.emplace_back([this]() { work(); });
+			}
+			catch (system_error const&)
+			{
+				break;
+			}
+		m_jobAvailable.notify_one();
+	}
+
+	~WorkerPool()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_jobAvailable.notify_all();
+		for (thread& worker: m_workers)
+			worker.join();
+	}
+
+private:
+	WorkerPool() = default;
+
+	void work()
+	{
+		while (true)
+		{
+			function<void()> job;
+			{
+				unique_lock<mutex> lock(m_mutex);
+				m_jobAvailable.wait(lock, [&]() { return m_stopping || !m_jobs.empty(); });
+				if (m_stopping)
+					return;
+				job = std::move(m_jobs.front());
+				m_jobs.pop_front();
+			}
+			job();
+		}
+	}
+
+	mutex m_mutex;
+	condition_variable m_jobAvailable;
+	deque<function<void()>> m_jobs;
+	vector<thread> m_workers;
+	bool m_stopping = false;
+};
+
+/// Calls @a _task for all indices below @a _count, using up to @a _threads threads including the calling one.
+/// If some of the calls throw, the exception of the lowest index is rethrown, i.e. the one
+/// that would have been thrown if the calls had been made in order.
+/// The calling thread works on the indices itself and only waits for the ones taken by workers,
+/// so nested calls from within a task cannot deadlock even if all workers are busy.
+void forEachConcurrently(size_t _count, size_t _threads, function<void(size_t)> const& _task)
+{
+	// Workers can start after all indices were taken, so they must not refer to our stack.
+	struct State
+	{
+		function<void(size_t)> const* task = nullptr;
+		size_t count = 0;
+		atomic<size_t> nextIndex{0};
+		vector<exception_ptr> errors;
+		mutex finishedMutex;
+		condition_variable allFinished;
+		size_t finishedCount = 0;
+	};
+	auto state = make_shared<State>();
+	state->task = &_task;
+	state->count = _count;
+	state->errors.resize(_count);
+
+	auto work = [](State& _state) {
+		for (size_t index = _state.nextIndex++; index < _state.count; index = _state.nextIndex++)
+		{
+			try
+			{
+				(*_state.task)(index);
+			}
+			catch (...)
+			{
+				_state.errors[index] = current_exception();
+			}
+			lock_guard<mutex> lock(_state.finishedMutex);
+			if (++_state.finishedCount == _state.count)
+				_state.allFinished.notify_all();
+		}
+	};
+
+	size_t const workerCount = max<size_t>(_threads, 1) - 1;
+	for (size_t i = 0; i + 1 < min(_threads, _count); ++i)
+		WorkerPool::instance().submit([state, work]() { work(*state); }, workerCount);
+	work(*state);
+	{
+		unique_lock<mutex> lock(state->finishedMutex);
+		state->allFinished.wait(lock, [&]() { return state->finishedCount == _count; });
+	}
+
+	for (exception_ptr const& error: state->errors)
+		if (error)
+			rethrow_exception(error);
+}
+
+/// @returns a hash of the items that is compatible with their equality operator.
+size_t hashItems(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end)
+{
+	size_t hash = 0;
+	for (auto it = _begin; it != _end; ++it)
+	{
+		boost::hash_combine(hash, static_cast<int>(it->type()));
+		if (it->type() == Operation)
+			boost::hash_combine(hash, static_cast<int>(it->instruction()));
+		else if (it->type() != VerbatimBytecode)
+			boost::hash_combine(hash, static_cast<size_t>(it->data() & numeric_limits<size_t>::max()));
+	}
+	return hash;
+}
+
+}
+
 AssemblyItem const& Assembly::append(AssemblyItem _i)
 {
 	assertThrow(m_deposit >= 0, AssemblyException, "Stack underflow.");
@@ -339,6 +493,28 @@ Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 	return *this;
 }
 
+void Assembly::collectUnoptimisedAssemblies(set<Assembly const*>& _assemblies) const
+{
+	if (m_tagReplacements || !_assemblies.insert(this).second)
+		return;
+	for (auto const& sub: m_subs)
+		sub->collectUnoptimisedAssemblies(_assemblies);
+}
+
+bool Assembly::subAssembliesIndependent() const
+{
+	set<Assembly const*> reachableFromPreviousSubs;
+	for (auto const& sub: m_subs)
+	{
+		set<Assembly const*> reachable;
+		sub->collectUnoptimisedAssemblies(reachable);
+		for (Assembly const* assembly: reachable)
+			if (!reachableFromPreviousSubs.insert(assembly).second)
+				return false;
+	}
+	return true;
+}
+
 map<u256, u256> const& Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
@@ -348,25 +524,61 @@ map<u256, u256> const& Assembly::optimiseInternal(
 		return *m_tagReplacements;
 
 	// Run optimisation for sub-assemblies.
+	// The replacements of a sub-assembly only affect the items referring to that sub-assembly,
+	// so they can be applied after all of them have been optimised.
+	vector<set<size_t>> tagsReferencedFromSubs;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
-	{
-		OptimiserSettings settings = _settings;
-		Assembly& sub = *m_subs[subId];
-		map<u256, u256> const& subTagReplacements = sub.optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
+		tagsReferencedFromSubs.emplace_back(JumpdestRemover::referencedTags(m_items, subId));
+	vector<map<u256, u256> const*> subTagReplacements(m_subs.size(), nullptr);
+	auto optimiseSub = [&](size_t _subId) {
+		subTagReplacements[_subId] = &m_subs[_subId]->optimiseInternal(
+			_settings,
+			std::move(tagsReferencedFromSubs[_subId])
 		);
+	};
+	// A sub-assembly shared between several of our sub-assemblies is optimised with the tags
+	// referenced from the first one, so we have to keep the order in that case.
+	if (_settings.jobs > 1 && m_subs.size() > 1 && subAssembliesIndependent())
+		forEachConcurrently(m_subs.size(), _settings.jobs, optimiseSub);
+	else
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			optimiseSub(subId);
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
 		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
-	}
+		BlockDeduplicator::applyTagReplacement(m_items, *subTagReplacements[subId], subId);
+
+	// Only engaged if a profile was requested, so that the default case does not allocate.
+	auto measure = [&](char const* _pass) -> optional<util::OptimiserProfile::Measurement> {
+		if (!_settings.profile)
+			return nullopt;
+		// Unnamed assemblies are only produced by the legacy code generator, which does not
+		// create more than one of each kind per contract.
+		// The passes are prefixed to tell them apart from Yul optimiser steps run on the same object.
+		return optional<util::OptimiserProfile::Measurement>(
+			in_place,
+			_settings.profile.get(),
+			!m_name.empty() ? m_name : isCreation() ? "<creation>" : "<runtime>",
+			"evmasm:"s + _pass,
+			[this]() { return m_items.size(); }
+		);
+	};
 
 	map<u256, u256> tagReplacements;
-	// Iterate until no new optimisation possibilities are found.
-	for (unsigned count = 1; count > 0;)
+	// Chunks the common subexpression eliminator could not improve in its last run, by hash, as
+	// ranges of the items it produced. Chunks that were not modified by the other passes in the
+	// meantime do not have to be analysed again.
+	AssemblyItems unimprovableChunksItems;
+	unordered_multimap<size_t, pair<size_t, size_t>> unimprovableChunks;
+	optional<bool> unimprovableChunksUseMSize;
+	// Iterate until no new optimisation possibilities are found or the budget is exhausted.
+	unsigned count = 1;
+	for (size_t iterations = 0; count > 0 && iterations < _settings.maxIterations; ++iterations)
 	{
 		count = 0;
 
 		if (_settings.runInliner)
+		{
+			auto measurement = measure("Inliner");
 			Inliner{
 				m_items,
 				_tagsReferencedFromOutside,
@@ -374,9 +586,11 @@ map<u256, u256> const& Assembly::optimiseInternal(
 				isCreation(),
 				_settings.evmVersion
 			}.optimise();
+		}
 
 		if (_settings.runJumpdestRemover)
 		{
+			auto measurement = measure("JumpdestRemover");
 			JumpdestRemover jumpdestOpt{m_items};
 			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
 				count++;
@@ -384,17 +598,15 @@ map<u256, u256> const& Assembly::optimiseInternal(
 
 		if (_settings.runPeephole)
 		{
-			PeepholeOptimiser peepOpt{m_items};
-			while (peepOpt.optimise())
-			{
+			auto measurement = measure("PeepholeOptimiser");
+			if (PeepholeOptimiser{m_items}.optimise())
 				count++;
-				assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
-			}
 		}
 
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
+			auto measurement = measure("BlockDeduplicator");
 			BlockDeduplicator deduplicator{m_items};
 			if (deduplicator.deduplicate())
 			{
@@ -423,16 +635,51 @@ map<u256, u256> const& Assembly::optimiseInternal(
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
+			auto measurement = measure("CommonSubexpressionEliminator");
 			AssemblyItems optimisedItems;
 
 			bool usesMSize = ranges::any_of(m_items, [](AssemblyItem const& _i) {
 				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
 			});
 
+			if (unimprovableChunksUseMSize != usesMSize)
+			{
+				unimprovableChunks.clear();
+				unimprovableChunksUseMSize = usesMSize;
+			}
+			unordered_multimap<size_t, pair<size_t, size_t>> newUnimprovableChunks;
+
+			// Every chunk starts from an empty state, but the classes are reused to avoid
+			// allocating their memory again for each chunk.
+			auto expressionClasses = make_shared<ExpressionClasses>();
 			auto iter = m_items.begin();
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
+				auto chunkEnd = CommonSubexpressionEliminator::chunkEnd(iter, m_items.end(), usesMSize);
+				size_t chunkHash = hashItems(iter, chunkEnd);
+				auto [candidate, candidatesEnd] = unimprovableChunks.equal_range(chunkHash);
+				for (; candidate != candidatesEnd; ++candidate)
+				{
+					auto const [begin, end] = candidate->second;
+					if (equal(
+						iter,
+						chunkEnd,
+						unimprovableChunksItems.begin() + static_cast<ptrdiff_t>(begin),
+						unimprovableChunksItems.begin() + static_cast<ptrdiff_t>(end)
+					))
+						break;
+				}
+				if (candidate != candidatesEnd)
+				{
+					size_t const begin = optimisedItems.size();
+					copy(iter, chunkEnd, back_inserter(optimisedItems));
+					newUnimprovableChunks.emplace(chunkHash, make_pair(begin, optimisedItems.size()));
+					iter = chunkEnd;
+					continue;
+				}
+
+				expressionClasses->clear();
+				KnownState emptyState{expressionClasses};
 				CommonSubexpressionEliminator eliminator{emptyState};
 				auto orig = iter;
 				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
@@ -460,28 +707,46 @@ map<u256, u256> const& Assembly::optimiseInternal(
 					optimisedItems += optimisedChunk;
 				}
 				else
+				{
+					size_t const begin = optimisedItems.size();
 					copy(orig, iter, back_inserter(optimisedItems));
+					newUnimprovableChunks.emplace(chunkHash, make_pair(begin, optimisedItems.size()));
+				}
 			}
 			if (optimisedItems.size() < m_items.size())
 			{
-				m_items = std::move(optimisedItems);
+				m_items = optimisedItems;
 				count++;
 			}
+			unimprovableChunks = std::move(newUnimprovableChunks);
+			unimprovableChunksItems = std::move(optimisedItems);
 		}
 	}
+	// The passes still changed the code in the last iteration, so they might have improved it further.
+	m_optimiserIterationLimitReached = count > 0;
 
 	if (_settings.runConstantOptimiser)
+	{
+		auto measurement = measure("ConstantOptimiser");
 		ConstantOptimisationMethod::optimiseConstants(
 			isCreation(),
 			isCreation() ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
 			*this
 		);
+	}
 
 	m_tagReplacements = std::move(tagReplacements);
 	return *m_tagReplacements;
 }
 
+bool Assembly::optimiserIterationLimitReached() const
+{
+	return m_optimiserIterationLimitReached || ranges::any_of(m_subs, [](AssemblyPointer const& _sub) {
+		return _sub->optimiserIterationLimitReached();
+	});
+}
+
 LinkerObject const& Assembly::assemble() const
 {
 	assertThrow(!m_invalid, AssemblyException, "Attempted to assemble invalid Assembly object.");
@@ -796,7 +1061,7 @@ Assembly const* Assembly::subAssemblyById(size_t _subId) const
 Assembly::OptimiserSettings Assembly::OptimiserSettings::translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0, nullptr};
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
@@ -805,5 +1070,8 @@ Assembly::OptimiserSettings Assembly::OptimiserSettings::translateSettings(front
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
 	asmSettings.evmVersion = _evmVersion;
+	asmSettings.profile = _settings.profile;
+	asmSettings.maxIterations = _settings.maxIterations;
+	asmSettings.jobs = _settings.jobs;
 	return asmSettings;
 }
@@ -129,6 +129,14 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = frontend::OptimiserSettings{}.expectedExecutionsPerDeployment;
+		/// If set, the time spent in each optimisation pass is recorded here.
+		std::shared_ptr<util::OptimiserProfile> profile;
+		/// Maximum number of times the passes are repeated. The code is used as it is after the last
+		/// repetition even if further improvements are possible, so that pathological inputs cannot
+		/// stall the compilation.
+		size_t maxIterations = frontend::OptimiserSettings{}.maxIterations;
+		/// Number of threads used to optimise independent sub-assemblies. Does not influence the result.
+		size_t jobs = 1;
 
 		static OptimiserSettings translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion);
 	};
@@ -136,6 +144,9 @@ public:
 	/// Modify and return the current assembly such that creation and execution gas usage
 	/// is optimised according to the settings in @a _settings.
 	Assembly& optimise(OptimiserSettings const& _settings);
+	/// @returns true if the optimiser stopped on this assembly or any of its sub-assemblies
+	/// because it reached OptimiserSettings::maxIterations while its passes were still changing the code.
+	bool optimiserIterationLimitReached() const;
 
 	/// Create a text representation of the assembly.
 	std::string assemblyString(
@@ -169,6 +180,13 @@ protected:
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> const& optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
 
+	/// Adds this assembly and all its transitive sub-assemblies that have not been optimised yet
+	/// to @a _assemblies.
+	void collectUnoptimisedAssemblies(std::set<Assembly const*>& _assemblies) const;
+	/// @returns true if no assembly that still has to be optimised is reachable from more than one
+	/// of the direct sub-assemblies, i.e. if the sub-assemblies can be optimised independently.
+	bool subAssembliesIndependent() const;
+
 	unsigned codeSize(unsigned subTagSize) const;
 
 private:
@@ -205,6 +223,8 @@ protected:
 	/// Contains the tag replacements relevant for super-assemblies.
 	/// If set, it means the optimizer has run and we will not run it again.
 	std::optional<std::map<u256, u256>> m_tagReplacements;
+	/// True, if the optimiser stopped because it reached the iteration limit.
+	bool m_optimiserIterationLimitReached = false;
 
 	mutable LinkerObject m_assembledObject;
 	mutable std::vector<size_t> m_tagPositionsInBytecode;
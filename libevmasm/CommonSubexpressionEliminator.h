@@ -74,6 +74,11 @@ public:
 	template <class AssemblyItemIterator>
 	AssemblyItemIterator feedItems(AssemblyItemIterator _iterator, AssemblyItemIterator _end, bool _msizeImportant);
 
+	/// @returns the iterator @a feedItems would return for the same arguments, i.e. the end of
+	/// the chunk of items a single instance of the eliminator analyses.
+	template <class AssemblyItemIterator>
+	static AssemblyItemIterator chunkEnd(AssemblyItemIterator _iterator, AssemblyItemIterator _end, bool _msizeImportant);
+
 	/// @returns the resulting items after optimization.
 	AssemblyItems getOptimizedItems();
 
@@ -84,6 +89,8 @@ private:
 	/// Tries to optimize the item that breaks the basic block at the end.
 	void optimizeBreakingItem();
 
+	static unsigned constexpr c_maxChunkSize = 2000;
+
 	KnownState m_initialState;
 	KnownState m_state;
 	/// Keeps information about which storage or memory slots were written to at which sequence
@@ -179,17 +186,38 @@ AssemblyItemIterator CommonSubexpressionEliminator::feedItems(
 )
 {
 	assertThrow(!m_breakingItem, OptimizerException, "Invalid use of CommonSubexpressionEliminator.");
-	unsigned const maxChunkSize = 2000;
 	unsigned chunkSize = 0;
 	for (
 		;
-		_iterator != _end && !SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant) && chunkSize < maxChunkSize;
+		_iterator != _end && !SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant) && chunkSize < c_maxChunkSize;
 		++_iterator, ++chunkSize
 	)
 		feedItem(*_iterator);
-	if (_iterator != _end && chunkSize < maxChunkSize)
+	if (_iterator != _end && chunkSize < c_maxChunkSize)
 		m_breakingItem = &(*_iterator++);
 	return _iterator;
 }
 
+template <class AssemblyItemIterator>
+AssemblyItemIterator CommonSubexpressionEliminator::chunkEnd(
+	AssemblyItemIterator _iterator,
+	AssemblyItemIterator _end,
+	bool _msizeImportant
+)
+{
+	unsigned chunkSize = 0;
+	while (
+		_iterator != _end &&
+		!SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant) &&
+		chunkSize < c_maxChunkSize
+	)
+	{
+		++_iterator;
+		++chunkSize;
+	}
+	if (_iterator != _end && chunkSize < c_maxChunkSize)
+		++_iterator;
+	return _iterator;
+}
+
 }
@@ -181,8 +181,20 @@ u256 const* ExpressionClasses::knownConstant(Id _c)
 
 AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
 {
-	m_spareAssemblyItems.push_back(make_shared<AssemblyItem>(_item));
-	return m_spareAssemblyItems.back().get();
+	m_spareAssemblyItems.push_back(_item);
+	return &m_spareAssemblyItems.back();
+}
+
+void ExpressionClasses::clear()
+{
+	m_representatives.clear();
+	// Clearing takes time proportional to the number of buckets, so do not keep the buckets
+	// of an unusually large set of expressions around.
+	if (m_expressions.bucket_count() > 1024)
+		m_expressions = {};
+	else
+		m_expressions.clear();
+	m_spareAssemblyItems.clear();
 }
 
 string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
@@ -204,7 +216,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules store the matched expressions, so every thread needs its own copy.
+	thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
@@ -28,6 +28,7 @@
 
 #include <libsolutil/Common.h>
 
+#include <deque>
 #include <memory>
 #include <unordered_set>
 #include <vector>
@@ -115,6 +116,9 @@ public:
 
 	std::string fullDAGToString(Id _id) const;
 
+	/// Removes all classes and stored items, but keeps memory allocated for reuse.
+	void clear();
+
 private:
 	/// Tries to simplify the given expression.
 	/// @returns its class if it possible or Id(-1) otherwise.
@@ -129,7 +133,8 @@ private:
 	std::vector<Expression> m_representatives;
 	/// All expression ever encountered.
 	std::unordered_set<Expression, Expression::ExpressionHash> m_expressions;
-	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
+	/// Items stored by @a storeItem. A deque does not move its elements when it grows.
+	std::deque<AssemblyItem> m_spareAssemblyItems;
 };
 
 }
@@ -24,32 +24,13 @@
 
 #pragma once
 
-#if defined(__clang__)
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wredeclared-class-member"
-#endif // defined(__clang__)
-
-// Disable warning about nodiscard. Could be a compiler bug, might be removed in the future.
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable: 4834)
-#endif
-
-#include <boost/bimap.hpp>
-
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
-
-#if defined(__clang__)
-#pragma clang diagnostic pop
-#endif // defined(__clang__)
-
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
 #include <libevmasm/ExpressionClasses.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <boost/container/flat_map.hpp>
+
 #include <limits>
 #include <utility>
 #include <vector>
@@ -77,11 +58,16 @@ using AssemblyItems = std::vector<AssemblyItem>;
  * The general workings are that for each assembly item that is fed, an equivalence class is
  * derived from the operation and the equivalence class of its arguments. DUPi, SWAPi and some
  * arithmetic instructions are used to infer equivalences while these classes are determined.
+ *
+ * The knowledge is usually small, but states are copied often, so it is stored in sorted vectors
+ * rather than in node-based maps.
  */
 class KnownState
 {
 public:
 	using Id = ExpressionClasses::Id;
+	template <class Key, class Value>
+	using Map = boost::container::flat_map<Key, Value>;
 	struct StoreOperation
 	{
 		enum Target { Invalid, Memory, Storage };
@@ -146,10 +132,10 @@ public:
 	void clearTagUnions();
 
 	int stackHeight() const { return m_stackHeight; }
-	std::map<int, Id> const& stackElements() const { return m_stackElements; }
+	Map<int, Id> const& stackElements() const { return m_stackElements; }
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
-	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	Map<Id, Id> const& storageContent() const { return m_storageContent; }
 
 private:
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
@@ -178,22 +164,23 @@ private:
 	/// Current stack height, can be negative.
 	int m_stackHeight = 0;
 	/// Current stack layout, mapping stack height -> equivalence class
-	std::map<int, Id> m_stackElements;
+	Map<int, Id> m_stackElements;
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
-	std::map<Id, Id> m_storageContent;
+	Map<Id, Id> m_storageContent;
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
-	std::map<Id, Id> m_memoryContent;
+	Map<Id, Id> m_memoryContent;
 	/// Keeps record of all Keccak-256 hashes that are computed. The first parameter in the
 	/// std::pair corresponds to memory content and the second parameter corresponds to the length
 	/// that is accessed.
-	std::map<std::pair<std::vector<Id>, unsigned>, Id> m_knownKeccak256Hashes;
+	Map<std::pair<std::vector<Id>, unsigned>, Id> m_knownKeccak256Hashes;
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
-	/// Container for unions of tags stored on the stack.
-	boost::bimap<Id, std::set<u256>> m_tagUnions;
+	/// Unions of tags stored on the stack, by their class and by their tags.
+	std::map<Id, std::set<u256>> m_tagUnions;
+	std::map<std::set<u256>, Id> m_tagUnionIds;
 };
 
 }
@@ -25,6 +25,9 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <array>
+#include <list>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -34,10 +37,29 @@ using namespace solidity::evmasm;
 namespace
 {
 
+/// Number of items the rule with the largest window looks at.
+size_t constexpr c_maxWindowSize = 5;
+
+struct ItemNode
+{
+	AssemblyItem item;
+	/// Round in which the rules were last applied to a window containing this item, or
+	/// the upcoming round if this still has to happen.
+	size_t round = 0;
+	bool removed = false;
+};
+using ItemList = list<ItemNode>;
+
 struct OptimiserState
 {
-	AssemblyItems const& items;
-	size_t i;
+	/// The items starting at the current position, up to the size of the largest window.
+	array<AssemblyItem const*, c_maxWindowSize> window;
+	size_t windowSize;
+	/// The current position, for rules that have to look further ahead than the window.
+	ItemList::const_iterator position;
+	ItemList::const_iterator end;
+	/// Number of items replaced by the output of the rule that was applied.
+	size_t consumed;
 	back_insert_iterator<AssemblyItems> out;
 };
 
@@ -54,22 +76,23 @@ struct SimplePeepholeOptimizerMethod
 {
 	template <size_t... Indices>
 	static bool applyRule(
-		AssemblyItems::const_iterator _in,
+		array<AssemblyItem const*, c_maxWindowSize> const& _window,
 		back_insert_iterator<AssemblyItems> _out,
 		index_sequence<Indices...>
 	)
 	{
-		return Method::applySimple(_in[Indices]..., _out);
+		return Method::applySimple(*_window[Indices]..., _out);
 	}
 	static bool apply(OptimiserState& _state)
 	{
 		static constexpr size_t WindowSize = FunctionParameterCount<decltype(Method::applySimple)>::value - 1;
+		static_assert(WindowSize <= c_maxWindowSize);
 		if (
-			_state.i + WindowSize <= _state.items.size() &&
-			applyRule(_state.items.begin() + static_cast<ptrdiff_t>(_state.i), _state.out, make_index_sequence<WindowSize>{})
+			WindowSize <= _state.windowSize &&
+			applyRule(_state.window, _state.out, make_index_sequence<WindowSize>{})
 		)
 		{
-			_state.i += WindowSize;
+			_state.consumed = WindowSize;
 			return true;
 		}
 		else
@@ -77,18 +100,6 @@ struct SimplePeepholeOptimizerMethod
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity>
-{
-	static bool applySimple(
-		AssemblyItem const& _item,
-		back_insert_iterator<AssemblyItems> _out
-	)
-	{
-		*_out = _item;
-		return true;
-	}
-};
-
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 {
 	static bool applySimple(
@@ -460,27 +471,24 @@ struct UnreachableCode
 {
 	static bool apply(OptimiserState& _state)
 	{
-		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
-		auto end = _state.items.end();
-		if (it == end)
-			return false;
+		AssemblyItem const& item = *_state.window[0];
 		if (
-			it[0] != Instruction::JUMP &&
-			it[0] != Instruction::RETURN &&
-			it[0] != Instruction::STOP &&
-			it[0] != Instruction::INVALID &&
-			it[0] != Instruction::SELFDESTRUCT &&
-			it[0] != Instruction::REVERT
+			item != Instruction::JUMP &&
+			item != Instruction::RETURN &&
+			item != Instruction::STOP &&
+			item != Instruction::INVALID &&
+			item != Instruction::SELFDESTRUCT &&
+			item != Instruction::REVERT
 		)
 			return false;
 
-		ptrdiff_t i = 1;
-		while (it + i != end && it[i].type() != Tag)
+		size_t i = 1;
+		for (auto it = next(_state.position); it != _state.end && it->item.type() != Tag; ++it)
 			i++;
 		if (i > 1)
 		{
-			*_state.out = it[0];
-			_state.i += static_cast<size_t>(i);
+			*_state.out = item;
+			_state.consumed = i;
 			return true;
 		}
 		else
@@ -488,47 +496,180 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+bool applyMethods(OptimiserState&)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	return false;
 }
 
 template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+bool applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	return Method::apply(_state) || applyMethods(_state, _other...);
 }
 
-size_t numberOfPops(AssemblyItems const& _items)
+/**
+ * Applies the rules in rounds. In each round, the rules are applied from left to right to
+ * non-overlapping windows and the result is kept only if it improves the code.
+ *
+ * The rules only look at the items in their window to decide whether they match. Because of that,
+ * a round only has to visit the positions whose windows changed in the previous round. All other
+ * positions are known not to match and are skipped. The items are kept in a linked list, so that
+ * replacing a window does not move the items after it.
+ */
+class PeepholeRounds
 {
-	return static_cast<size_t>(std::count(_items.begin(), _items.end(), Instruction::POP));
-}
+public:
+	explicit PeepholeRounds(AssemblyItems& _items)
+	{
+		for (AssemblyItem& item: _items)
+			m_items.push_back({std::move(item), 0, false});
+		m_size = m_items.size();
+		for (auto it = m_items.begin(); it != m_items.end(); ++it)
+			m_positions.push_back(it);
+	}
+
+	/// Performs the next round.
+	/// @returns false if the round did not improve the code. Its changes are reverted in that case.
+	bool runRound()
+	{
+		m_round++;
+		// Avoid referencing immutables too early by using approx. counting in bytesRequired()
+		auto const approx = evmasm::Precision::Approximate;
+
+		vector<Replacement> replacements;
+		vector<ItemList::iterator> nextPositions;
+		size_t removedItems = 0;
+		size_t insertedItems = 0;
+		size_t removedBytes = 0;
+		size_t insertedBytes = 0;
+		size_t removedPops = 0;
+		size_t insertedPops = 0;
+		AssemblyItems output;
+		for (ItemList::iterator position: m_positions)
+		{
+			if (position->removed)
+				continue;
+
+			output.clear();
+			OptimiserState state{{}, 0, position, m_items.end(), 0, back_inserter(output)};
+			for (auto it = position; it != m_items.end() && state.windowSize < c_maxWindowSize; ++it)
+				state.window[state.windowSize++] = &it->item;
+			if (!applyMethods(
+				state,
+				PushPop(), OpPop(), OpStop(), OpReturnRevert(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
+				DupSwap(), IsZeroIsZeroJumpI(), EqIsZeroJumpI(), DoubleJump(), JumpToNext(), UnreachableCode(),
+				TagConjunctions(), TruthyAnd()
+			))
+				continue;
+
+			Replacement replacement{position, state.consumed, position, output.size()};
+			for (size_t i = 0; i < state.consumed; ++i, ++replacement.following)
+			{
+				replacement.following->removed = true;
+				removedBytes += replacement.following->item.bytesRequired(3, approx);
+				if (replacement.following->item == Instruction::POP)
+					removedPops++;
+			}
+			m_removed.splice(m_removed.end(), m_items, replacement.first, replacement.following);
+
+			auto inserted = m_items.end();
+			for (AssemblyItem& item: output)
+			{
+				insertedBytes += item.bytesRequired(3, approx);
+				if (item == Instruction::POP)
+					insertedPops++;
+				auto it = m_items.insert(replacement.following, {std::move(item), m_round + 1, false});
+				if (inserted == m_items.end())
+					inserted = it;
+			}
+			if (inserted == m_items.end())
+				inserted = replacement.following;
+			removedItems += replacement.replaced;
+			insertedItems += replacement.inserted;
+
+			// Besides the inserted items, the rules have to be applied again at the positions whose
+			// windows reach into them or across the replaced items.
+			vector<ItemList::iterator> preceding;
+			for (auto it = inserted; it != m_items.begin() && preceding.size() < c_maxWindowSize - 1;)
+			{
+				--it;
+				if (it->round == m_round + 1)
+					break;
+				it->round = m_round + 1;
+				preceding.push_back(it);
+			}
+			nextPositions.insert(nextPositions.end(), preceding.rbegin(), preceding.rend());
+			for (auto it = inserted; it != replacement.following; ++it)
+				nextPositions.push_back(it);
+			replacements.push_back(replacement);
+		}
+
+		size_t newSize = m_size - removedItems + insertedItems;
+		if (
+			newSize < m_size || (
+				newSize == m_size && (
+					insertedBytes < removedBytes ||
+					insertedPops > removedPops
+				)
+			)
+		)
+		{
+			m_size = newSize;
+			m_positions = std::move(nextPositions);
+			m_removed.clear();
+			return true;
+		}
+
+		// Later replacements may have removed the item following an earlier one,
+		// so they have to be reverted first.
+		for (auto it = replacements.rbegin(); it != replacements.rend(); ++it)
+		{
+			m_items.erase(prev(it->following, static_cast<ptrdiff_t>(it->inserted)), it->following);
+			m_items.splice(it->following, m_removed, it->first, next(it->first, static_cast<ptrdiff_t>(it->replaced)));
+		}
+		return false;
+	}
+
+	AssemblyItems items() &&
+	{
+		AssemblyItems items;
+		items.reserve(m_size);
+		for (ItemNode& node: m_items)
+			items.emplace_back(std::move(node.item));
+		return items;
+	}
+
+private:
+	struct Replacement
+	{
+		/// First of the replaced items. The items are moved to m_removed.
+		ItemList::iterator first;
+		size_t replaced;
+		/// The item following the replaced and the inserted items.
+		ItemList::iterator following;
+		size_t inserted;
+	};
+
+	ItemList m_items;
+	size_t m_size = 0;
+	/// Items replaced in the current round, kept until it is clear whether the round is kept.
+	ItemList m_removed;
+	/// Positions at which the rules have to be applied in the next round, in order.
+	vector<ItemList::iterator> m_positions;
+	size_t m_round = 0;
+};
 
 }
 
 bool PeepholeOptimiser::optimise()
 {
-	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
-	auto const approx = evmasm::Precision::Approximate;
-	OptimiserState state {m_items, 0, back_inserter(m_optimisedItems)};
-	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), OpStop(), OpReturnRevert(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), EqIsZeroJumpI(), DoubleJump(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
-	if (m_optimisedItems.size() < m_items.size() || (
-		m_optimisedItems.size() == m_items.size() && (
-			evmasm::bytesRequired(m_optimisedItems, 3, approx) < evmasm::bytesRequired(m_items, 3, approx) ||
-			numberOfPops(m_optimisedItems) > numberOfPops(m_items)
-		)
-	))
+	PeepholeRounds rounds{m_items};
+	size_t improvingRounds = 0;
+	while (rounds.runRound())
 	{
-		m_items = std::move(m_optimisedItems);
-		return true;
+		improvingRounds++;
+		assertThrow(improvingRounds < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
 	}
-	else
-		return false;
+	m_items = std::move(rounds).items();
+	return improvingRounds > 0;
 }
@@ -38,17 +38,22 @@ public:
 	virtual bool apply(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out);
 };
 
+/**
+ * Applies the peephole rules in rounds until a round does not improve the code anymore.
+ * After the first round, only the positions close to the changes of the previous round are visited,
+ * so the cost of the later rounds depends on the number of changes rather than on the size of the code.
+ */
 class PeepholeOptimiser
 {
 public:
 	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
 	virtual ~PeepholeOptimiser() = default;
 
+	/// @returns true if at least one round improved the code.
 	bool optimise();
 
 private:
 	AssemblyItems& m_items;
-	AssemblyItems m_optimisedItems;
 };
 
 }
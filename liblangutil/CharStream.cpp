@@ -82,15 +82,8 @@ char CharStream::setPosition(size_t _location)
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), size_type(_position));
-	if (searchStart > 0)
-		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
+	int const lineNumber = translatePositionToLineColumn(_position).line;
+	size_t const lineStart = m_lineStarts[static_cast<size_t>(lineNumber)];
 	string line = m_source.substr(
 		lineStart,
 		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
@@ -102,19 +95,11 @@ string CharStream::lineAtPosition(int _position) const
 
 LineColumn CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	using diff_type = string::difference_type;
-	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return LineColumn{lineNumber, static_cast<int>(searchPosition - lineStart)};
+	size_t const searchPosition = min<size_t>(m_source.size(), static_cast<size_t>(_position));
+	// The first line starts at zero, so this finds the last line starting at or before the position.
+	auto const nextLineStart = upper_bound(m_lineStarts.begin(), m_lineStarts.end(), searchPosition);
+	size_t const lineNumber = static_cast<size_t>(nextLineStart - m_lineStarts.begin()) - 1;
+	return LineColumn{static_cast<int>(lineNumber), static_cast<int>(searchPosition - m_lineStarts[lineNumber])};
 }
 
 string_view CharStream::text(SourceLocation const& _location) const
@@ -147,12 +132,22 @@ string CharStream::singleLineSnippet(string const& _sourceCode, SourceLocation c
 
 optional<int> CharStream::translateLineColumnToPosition(LineColumn const& _lineColumn) const
 {
-	return translateLineColumnToPosition(m_source, _lineColumn);
+	if (_lineColumn.line < 0 || _lineColumn.column < 0)
+		return nullopt;
+
+	size_t const line = static_cast<size_t>(_lineColumn.line);
+	if (line >= m_lineStarts.size())
+		return nullopt;
+
+	size_t const endOfLine = line + 1 < m_lineStarts.size() ? m_lineStarts[line + 1] - 1 : m_source.size();
+	if (m_lineStarts[line] + static_cast<size_t>(_lineColumn.column) > endOfLine)
+		return nullopt;
+	return static_cast<int>(m_lineStarts[line] + static_cast<size_t>(_lineColumn.column));
 }
 
 optional<int> CharStream::translateLineColumnToPosition(std::string const& _text, LineColumn const& _input)
 {
-	if (_input.line < 0)
+	if (_input.line < 0 || _input.column < 0)
 		return nullopt;
 
 	size_t offset = 0;
@@ -173,3 +168,14 @@ optional<int> CharStream::translateLineColumnToPosition(std::string const& _text
 	return offset + static_cast<size_t>(_input.column);
 }
 
+vector<size_t> CharStream::computeLineStarts(string const& _source)
+{
+	vector<size_t> lineStarts{0};
+	for (
+		size_t position = _source.find('\n');
+		position != string::npos;
+		position = _source.find('\n', position + 1)
+	)
+		lineStarts.push_back(position + 1);
+	return lineStarts;
+}
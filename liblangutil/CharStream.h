@@ -55,6 +55,7 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -72,11 +73,12 @@ class CharStream
 public:
 	CharStream() = default;
 	CharStream(std::string _source, std::string _name):
-		m_source(std::move(_source)), m_name(std::move(_name)) {}
+		m_source(std::move(_source)), m_name(std::move(_name)), m_lineStarts(computeLineStarts(m_source)) {}
 	CharStream(std::string _source, std::string _name, bool _importedFromAST):
 		m_source(std::move(_source)),
 		m_name(std::move(_name)),
-		m_importedFromAST(_importedFromAST)
+		m_importedFromAST(_importedFromAST),
+		m_lineStarts(computeLineStarts(m_source))
 	{ }
 
 	size_t position() const { return m_position; }
@@ -102,8 +104,8 @@ public:
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors and translating positions for the language server.
+	/// They take logarithmic time using an index of the line starts built on construction.
 	std::string lineAtPosition(int _position) const;
 	LineColumn translatePositionToLineColumn(int _position) const;
 	///@}
@@ -142,10 +144,16 @@ public:
 	static std::string singleLineSnippet(std::string const& _sourceCode, SourceLocation const& _location);
 
 private:
+	/// @returns the offsets at which the lines of @a _source start.
+	static std::vector<size_t> computeLineStarts(std::string const& _source);
+
 	std::string m_source;
 	std::string m_name;
 	bool m_importedFromAST{false};
 	size_t m_position{0};
+	/// Offset of the first character of each line. Built on construction and never modified
+	/// afterwards, so that several threads can translate positions of the same stream.
+	std::vector<size_t> m_lineStarts{0};
 };
 
 }
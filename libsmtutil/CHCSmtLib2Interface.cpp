@@ -18,6 +18,8 @@
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/Keccak256.h>
 
 #include <boost/algorithm/string/join.hpp>
@@ -207,11 +209,26 @@ string CHCSmtLib2Interface::querySolver(string const& _input)
 		return m_queryResponses.at(inputHash);
 
 	smtAssert(m_enabledSolvers.smtlib2 || m_enabledSolvers.eld);
+	// The solver behind the callback is not known, so the key only covers the query.
+	optional<util::h256> cacheKey;
+	if (m_queryCache)
+	{
+		cacheKey = QueryCache::key("chc-smtlib2", _input);
+		if (optional<string> response = m_queryCache->load(*cacheKey))
+			return *response;
+	}
 	if (m_smtCallback)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
+		{
+			if (
+				cacheKey &&
+				(boost::starts_with(result.responseOrErrorMessage, "sat") || boost::starts_with(result.responseOrErrorMessage, "unsat"))
+			)
+				m_queryCache->store(*cacheKey, result.responseOrErrorMessage);
 			return result.responseOrErrorMessage;
+		}
 	}
 
 	m_unhandledQueries.push_back(_input);
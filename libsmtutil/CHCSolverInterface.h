@@ -59,8 +59,13 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// Sets a persistent cache, which is consulted before solving a query
+	/// and which stores definitive answers.
+	void setQueryCache(std::shared_ptr<QueryCache> _cache) { m_queryCache = std::move(_cache); }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
+	std::shared_ptr<QueryCache> m_queryCache;
 };
 
 }
@@ -18,9 +18,12 @@
 
 #include <libsmtutil/CVC4Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
 
+#include <cvc4/base/configuration.h>
 #include <cvc4/util/bitvector.h>
 
 using namespace std;
@@ -40,6 +43,10 @@ void CVC4Interface::reset()
 	m_variables.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
+	// Needed to compute the keys of the query cache. Only enabled with a cache, since
+	// keeping the assertions costs memory and time.
+	if (m_queryCache)
+		m_solver.setOption("produce-assertions", true);
 	if (m_queryTimeout)
 		m_solver.setTimeLimit(*m_queryTimeout);
 	else
@@ -88,6 +95,22 @@ void CVC4Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	optional<h256> cacheKey;
+	if (m_queryCache)
+	{
+		string query;
+		for (auto const& [name, variable]: m_variables)
+			query += name + " " + variable.getType().toString() + "\n";
+		for (CVC4::Expr const& assertion: m_solver.getAssertions())
+			query += assertion.toString() + "\n";
+		for (Expression const& e: _expressionsToEvaluate)
+			query += toCVC4Expr(e).toString() + "\n";
+		cacheKey = QueryCache::key("cvc4 " + CVC4::Configuration::getVersionString(), query);
+		if (optional<string> response = m_queryCache->load(*cacheKey))
+			if (auto cachedResult = QueryCache::decodeCheckResult(*response))
+				return *cachedResult;
+	}
+
 	CheckResult result;
 	vector<string> values;
 	try
@@ -119,9 +142,31 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 		values.clear();
 	}
 
+	if (cacheKey && (result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE))
+		m_queryCache->store(*cacheKey, QueryCache::encode(result, values));
 	return make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	try
+	{
+		m_solver.interrupt();
+	}
+	catch (CVC4::Exception const&)
+	{
+		// Thrown if no query is running, in which case there is nothing to interrupt.
+	}
+}
+
+void CVC4Interface::setQueryCache(shared_ptr<QueryCache> _cache)
+{
+	smtAssert(m_variables.empty(), "The query cache has to be set before variables are declared.");
+	SolverInterface::setQueryCache(std::move(_cache));
+	// Options can only be changed before the solver is used.
+	reset();
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
 	// Variable
@@ -54,6 +54,9 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
+	/// Has to be called before any variable is declared, because it resets the solver.
+	void setQueryCache(std::shared_ptr<QueryCache> _cache) override;
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
@@ -0,0 +1,305 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/QueryCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+#include <fstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+map<CheckResult, string> const c_resultNames{
+	{CheckResult::SATISFIABLE, "sat"},
+	{CheckResult::UNSATISFIABLE, "unsat"},
+	{CheckResult::UNKNOWN, "unknown"},
+	{CheckResult::CONFLICTING, "conflicting"},
+	{CheckResult::ERROR, "error"}
+};
+
+CheckResult resultFromJson(Json::Value const& _json)
+{
+	for (auto const& [result, name]: c_resultNames)
+		if (_json.asString() == name)
+			return result;
+	throw Json::LogicError("Invalid check result.");
+}
+
+Json::Value toJson(Sort const& _sort)
+{
+	Json::Value json{Json::objectValue};
+	switch (_sort.kind)
+	{
+	case Kind::Int:
+		json["kind"] = "int";
+		json["signed"] = dynamic_cast<IntSort const&>(_sort).isSigned;
+		break;
+	case Kind::Bool:
+		json["kind"] = "bool";
+		break;
+	case Kind::BitVector:
+		json["kind"] = "bitvector";
+		json["size"] = dynamic_cast<BitVectorSort const&>(_sort).size;
+		break;
+	case Kind::Function:
+	{
+		auto const& functionSort = dynamic_cast<FunctionSort const&>(_sort);
+		json["kind"] = "function";
+		json["domain"] = Json::arrayValue;
+		for (SortPointer const& domain: functionSort.domain)
+			json["domain"].append(toJson(*domain));
+		json["codomain"] = toJson(*functionSort.codomain);
+		break;
+	}
+	case Kind::Array:
+	{
+		auto const& arraySort = dynamic_cast<ArraySort const&>(_sort);
+		json["kind"] = "array";
+		json["domain"] = toJson(*arraySort.domain);
+		json["range"] = toJson(*arraySort.range);
+		break;
+	}
+	case Kind::Sort:
+		json["kind"] = "sort";
+		json["inner"] = toJson(*dynamic_cast<SortSort const&>(_sort).inner);
+		break;
+	case Kind::Tuple:
+	{
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(_sort);
+		json["kind"] = "tuple";
+		json["name"] = tupleSort.name;
+		json["members"] = Json::arrayValue;
+		for (string const& member: tupleSort.members)
+			json["members"].append(member);
+		json["components"] = Json::arrayValue;
+		for (SortPointer const& component: tupleSort.components)
+			json["components"].append(toJson(*component));
+		break;
+	}
+	}
+	return json;
+}
+
+SortPointer sortFromJson(Json::Value const& _json)
+{
+	string const kind = _json["kind"].asString();
+	if (kind == "int")
+		return SortProvider::intSort(_json["signed"].asBool());
+	else if (kind == "bool")
+		return SortProvider::boolSort;
+	else if (kind == "bitvector")
+		return make_shared<BitVectorSort>(_json["size"].asUInt());
+	else if (kind == "function")
+	{
+		vector<SortPointer> domain;
+		for (auto const& sort: _json["domain"])
+			domain.emplace_back(sortFromJson(sort));
+		return make_shared<FunctionSort>(std::move(domain), sortFromJson(_json["codomain"]));
+	}
+	else if (kind == "array")
+		return make_shared<ArraySort>(sortFromJson(_json["domain"]), sortFromJson(_json["range"]));
+	else if (kind == "sort")
+		return make_shared<SortSort>(sortFromJson(_json["inner"]));
+	else if (kind == "tuple")
+	{
+		vector<string> members;
+		for (auto const& member: _json["members"])
+			members.emplace_back(member.asString());
+		vector<SortPointer> components;
+		for (auto const& component: _json["components"])
+			components.emplace_back(sortFromJson(component));
+		if (members.size() != components.size())
+			throw Json::LogicError("Invalid tuple sort.");
+		return make_shared<TupleSort>(_json["name"].asString(), std::move(members), std::move(components));
+	}
+	throw Json::LogicError("Invalid sort kind.");
+}
+
+Json::Value toJson(Expression const& _expression)
+{
+	Json::Value json{Json::objectValue};
+	json["name"] = _expression.name;
+	json["sort"] = toJson(*_expression.sort);
+	if (!_expression.arguments.empty())
+	{
+		json["arguments"] = Json::arrayValue;
+		for (Expression const& argument: _expression.arguments)
+			json["arguments"].append(toJson(argument));
+	}
+	return json;
+}
+
+Expression expressionFromJson(Json::Value const& _json)
+{
+	vector<Expression> arguments;
+	for (auto const& argument: _json["arguments"])
+		arguments.emplace_back(expressionFromJson(argument));
+	return Expression(_json["name"].asString(), std::move(arguments), sortFromJson(_json["sort"]));
+}
+
+optional<Json::Value> parseObject(string const& _response)
+{
+	Json::Value json;
+	if (!jsonParseStrict(_response, json) || !json.isObject())
+		return nullopt;
+	return json;
+}
+
+}
+
+h256 QueryCache::key(string const& _solver, string const& _query)
+{
+	return keccak256(_solver + "\n" + _query);
+}
+
+optional<string> QueryCache::load(h256 const& _key)
+{
+	fs::path const path = m_directory / _key.hex();
+	boost::system::error_code error;
+	if (fs::is_regular_file(path, error))
+		try
+		{
+			return readFileAsString(path);
+		}
+		catch (Exception const&)
+		{
+			// The directory might have been cleared concurrently.
+		}
+	return nullopt;
+}
+
+void QueryCache::store(h256 const& _key, string const& _response)
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	// Write to a temporary file first, so that concurrent readers never see partial entries.
+	fs::path const path = m_directory / _key.hex();
+	fs::path const temporaryPath = fs::unique_path(path.string() + ".%%%%%%%%.tmp", error);
+	if (error)
+		return;
+	{
+		ofstream file(temporaryPath.string(), ios::out | ios::trunc | ios::binary);
+		file << _response;
+		if (!file)
+		{
+			fs::remove(temporaryPath, error);
+			return;
+		}
+	}
+	fs::rename(temporaryPath, path, error);
+	if (error)
+		fs::remove(temporaryPath, error);
+}
+
+string QueryCache::encode(CheckResult _result, vector<string> const& _values)
+{
+	Json::Value json{Json::objectValue};
+	json["result"] = c_resultNames.at(_result);
+	json["values"] = Json::arrayValue;
+	for (string const& value: _values)
+		json["values"].append(value);
+	return jsonCompactPrint(json);
+}
+
+optional<pair<CheckResult, vector<string>>> QueryCache::decodeCheckResult(string const& _response)
+{
+	optional<Json::Value> json = parseObject(_response);
+	if (!json)
+		return nullopt;
+	try
+	{
+		pair<CheckResult, vector<string>> result{resultFromJson((*json)["result"]), {}};
+		for (auto const& value: (*json)["values"])
+			result.second.emplace_back(value.asString());
+		return result;
+	}
+	catch (Json::Exception const&)
+	{
+		return nullopt;
+	}
+}
+
+string QueryCache::encode(
+	CheckResult _result,
+	Expression const& _invariant,
+	CHCSolverInterface::CexGraph const& _cex
+)
+{
+	Json::Value json{Json::objectValue};
+	json["result"] = c_resultNames.at(_result);
+	json["invariant"] = toJson(_invariant);
+	json["nodes"] = Json::objectValue;
+	for (auto const& [id, node]: _cex.nodes)
+		json["nodes"][to_string(id)] = toJson(node);
+	json["edges"] = Json::objectValue;
+	for (auto const& [id, successors]: _cex.edges)
+	{
+		Json::Value& edges = json["edges"][to_string(id)] = Json::arrayValue;
+		for (unsigned successor: successors)
+			edges.append(successor);
+	}
+	return jsonCompactPrint(json);
+}
+
+optional<tuple<CheckResult, Expression, CHCSolverInterface::CexGraph>> QueryCache::decodeQueryResult(
+	string const& _response
+)
+{
+	optional<Json::Value> json = parseObject(_response);
+	if (!json)
+		return nullopt;
+	try
+	{
+		CHCSolverInterface::CexGraph cex;
+		for (string const& id: (*json)["nodes"].getMemberNames())
+			cex.nodes.emplace(static_cast<unsigned>(stoul(id)), expressionFromJson((*json)["nodes"][id]));
+		for (string const& id: (*json)["edges"].getMemberNames())
+		{
+			vector<unsigned>& successors = cex.edges[static_cast<unsigned>(stoul(id))];
+			for (auto const& successor: (*json)["edges"][id])
+				successors.push_back(successor.asUInt());
+		}
+		return tuple{
+			resultFromJson((*json)["result"]),
+			expressionFromJson((*json)["invariant"]),
+			std::move(cex)
+		};
+	}
+	catch (Json::Exception const&)
+	{
+		return nullopt;
+	}
+	catch (logic_error const&)
+	{
+		// Node ids that are not numbers.
+		return nullopt;
+	}
+}
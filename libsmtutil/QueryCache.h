@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/SolverInterface.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Persistent cache of the answers of SMT and Horn solvers, stored as one file per query
+ * in a directory, so that the answers can be reused by later runs of the compiler.
+ *
+ * The key covers the solver including its version and the full text of the query.
+ * Only SAT and UNSAT answers should be stored: they do not depend on timeouts or
+ * resource limits. The directory is never cleaned up automatically.
+ */
+class QueryCache
+{
+public:
+	explicit QueryCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the key of @a _query sent to @a _solver, which has to identify
+	/// the solver and its version.
+	static util::h256 key(std::string const& _solver, std::string const& _query);
+
+	/// @returns the response stored under @a _key, if any.
+	std::optional<std::string> load(util::h256 const& _key);
+	/// Stores @a _response under @a _key. Failures to write are ignored.
+	void store(util::h256 const& _key, std::string const& _response);
+
+	/// Conversion of the results of SolverInterface::check to and from the stored format.
+	static std::string encode(CheckResult _result, std::vector<std::string> const& _values);
+	/// @returns nullopt if @a _response is not a valid result.
+	static std::optional<std::pair<CheckResult, std::vector<std::string>>> decodeCheckResult(std::string const& _response);
+
+	/// Conversion of the results of CHCSolverInterface::query to and from the stored format.
+	static std::string encode(
+		CheckResult _result,
+		Expression const& _invariant,
+		CHCSolverInterface::CexGraph const& _cex
+	);
+	/// @returns nullopt if @a _response is not a valid result.
+	static std::optional<std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph>> decodeQueryResult(
+		std::string const& _response
+	);
+
+private:
+	boost::filesystem::path m_directory;
+};
+
+}
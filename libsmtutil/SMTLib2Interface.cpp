@@ -18,6 +18,8 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/Keccak256.h>
 
 #include <boost/algorithm/string/join.hpp>
@@ -313,11 +315,26 @@ string SMTLib2Interface::querySolver(string const& _input)
 	h256 inputHash = keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	// The solver behind the callback is not known, so the key only covers the query.
+	optional<h256> cacheKey;
+	if (m_queryCache)
+	{
+		cacheKey = QueryCache::key("smtlib2", _input);
+		if (optional<string> response = m_queryCache->load(*cacheKey))
+			return *response;
+	}
 	if (m_smtCallback)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
+		{
+			if (
+				cacheKey &&
+				(boost::starts_with(result.responseOrErrorMessage, "sat\n") || boost::starts_with(result.responseOrErrorMessage, "unsat\n"))
+			)
+				m_queryCache->store(*cacheKey, result.responseOrErrorMessage);
 			return result.responseOrErrorMessage;
+		}
 	}
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
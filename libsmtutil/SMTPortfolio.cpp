@@ -26,6 +26,13 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -36,9 +43,11 @@ SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	bool _raceSolvers
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_raceSolvers(_raceSolvers)
 {
 	if (_enabledSolvers.smtlib2)
 		m_solvers.emplace_back(make_unique<SMTLib2Interface>(std::move(_smtlib2Responses), std::move(_smtCallback), m_queryTimeout));
@@ -52,10 +61,22 @@ SMTPortfolio::SMTPortfolio(
 #endif
 }
 
+SMTPortfolio::SMTPortfolio(
+	vector<unique_ptr<SolverInterface>> _solvers,
+	optional<unsigned> _queryTimeout,
+	bool _raceSolvers
+):
+	SolverInterface(_queryTimeout),
+	m_solvers(std::move(_solvers)),
+	m_raceSolvers(_raceSolvers)
+{
+}
+
 void SMTPortfolio::reset()
 {
 	for (auto const& s: m_solvers)
 		s->reset();
+	m_declarations.clear();
 }
 
 void SMTPortfolio::push()
@@ -75,6 +96,7 @@ void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort
 	smtAssert(_sort, "");
 	for (auto const& s: m_solvers)
 		s->declareVariable(_name, _sort);
+	m_declarations.emplace_back(_name, _sort);
 }
 
 void SMTPortfolio::addAssertion(Expression const& _expr)
@@ -112,35 +134,49 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * In racing mode all solvers get the query at the same time, each on its own thread.
+ * The solvers have a fixed precedence, which is their order in the list: the result is
+ * the answer of the first solver in the list that answers, together with its model values.
+ * Once a solver answered, the solvers after it are interrupted and their results are
+ * ignored, while the solvers before it are waited for. The result therefore does not
+ * depend on the order in which the solvers finish. Conflicting answers are not detected
+ * in this mode, since that would require waiting for all solvers.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	if (m_raceSolvers && m_solvers.size() > 1)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
-		if (solverAnswered(result))
+		for (auto& solverResult: raceSolvers(_expressionsToEvaluate))
 		{
-			if (!solverAnswered(lastResult))
-			{
-				lastResult = result;
-				finalValues = std::move(values);
-			}
-			else if (lastResult != result)
-			{
-				lastResult = CheckResult::CONFLICTING;
+			bool const answered = solverAnswered(solverResult.first);
+			mergeResult(lastResult, finalValues, std::move(solverResult));
+			// The solvers after the first one that answered were interrupted.
+			if (answered)
 				break;
-			}
 		}
-		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
-			lastResult = result;
 	}
+	else
+		for (auto const& s: m_solvers)
+			if (!mergeResult(lastResult, finalValues, s->check(_expressionsToEvaluate)))
+				break;
 	return make_pair(lastResult, finalValues);
 }
 
+void SMTPortfolio::interrupt()
+{
+	for (auto const& s: m_solvers)
+		s->interrupt();
+}
+
+void SMTPortfolio::setQueryCache(shared_ptr<QueryCache> _cache)
+{
+	for (auto const& s: m_solvers)
+		s->setQueryCache(_cache);
+}
+
 vector<string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
@@ -151,6 +187,118 @@ vector<string> SMTPortfolio::unhandledQueries()
 	return {};
 }
 
+vector<pair<CheckResult, vector<string>>> SMTPortfolio::raceSolvers(vector<Expression> const& _expressionsToEvaluate)
+{
+	size_t const solverCount = m_solvers.size();
+	// Solvers that are not needed anymore when they would start count as not having answered.
+	vector<pair<CheckResult, vector<string>>> results(solverCount, {CheckResult::UNKNOWN, {}});
+	vector<exception_ptr> errors(solverCount);
+	// Guards the fields below. Signalled whenever a solver returns.
+	mutex stateMutex;
+	condition_variable solverReturned;
+	vector<bool> finished(solverCount, false);
+	// The first solver in the list that answered so far.
+	optional<size_t> winner;
+
+	auto run = [&](size_t _index) {
+		{
+			lock_guard<mutex> lock(stateMutex);
+			if (winner && *winner < _index)
+			{
+				finished[_index] = true;
+				solverReturned.notify_all();
+				return;
+			}
+		}
+		try
+		{
+			results[_index] = m_solvers[_index]->check(_expressionsToEvaluate);
+		}
+		catch (...)
+		{
+			errors[_index] = current_exception();
+		}
+
+		unique_lock<mutex> lock(stateMutex);
+		finished[_index] = true;
+		solverReturned.notify_all();
+		if (!solverAnswered(results[_index].first) || (winner && *winner < _index))
+			return;
+		winner = _index;
+		// Interrupts the solvers with lower precedence until they return or a solver with
+		// higher precedence answers, which then takes over. Solvers drop interrupts that
+		// arrive before their query is running, so the interrupt is repeated whenever the
+		// wait times out.
+		auto const losersRunning = [&]() {
+			for (size_t other = _index + 1; other < solverCount; ++other)
+				if (!finished[other])
+					return true;
+			return false;
+		};
+		while (winner == _index && losersRunning())
+		{
+			for (size_t other = _index + 1; other < solverCount; ++other)
+				if (!finished[other])
+					m_solvers[other]->interrupt();
+			solverReturned.wait_for(lock, chrono::milliseconds(10));
+		}
+	};
+
+	// The first solver runs on the calling thread. This is the SMT-LIB2 interface if it is
+	// enabled, whose query callback is not required to be thread-safe.
+	vector<thread> threads;
+	vector<size_t> notStarted;
+	for (size_t index = 1; index < solverCount; ++index)
+		try
+		{
+			threads.emplace_back(run, index);
+		}
+		catch (system_error const&)
+		{
+			// Runs after the others have finished, so there is nothing to interrupt.
+			finished[index] = true;
+			notStarted.push_back(index);
+		}
+	run(0);
+	for (thread& solverThread: threads)
+		solverThread.join();
+	for (size_t index: notStarted)
+	{
+		finished[index] = false;
+		run(index);
+	}
+
+	for (exception_ptr const& error: errors)
+		if (error)
+			rethrow_exception(error);
+	return results;
+}
+
+bool SMTPortfolio::mergeResult(
+	CheckResult& _result,
+	vector<string>& _values,
+	pair<CheckResult, vector<string>> _solverResult
+)
+{
+	auto&& [result, values] = _solverResult;
+	if (solverAnswered(result))
+	{
+		if (!solverAnswered(_result))
+		{
+			_result = result;
+			_values = std::move(values);
+		}
+		else if (_result != result)
+		{
+			_result = CheckResult::CONFLICTING;
+			return false;
+		}
+	}
+	else if (result == CheckResult::UNKNOWN && _result == CheckResult::ERROR)
+		_result = result;
+	return true;
+}
+
 bool SMTPortfolio::solverAnswered(CheckResult result)
 {
 	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
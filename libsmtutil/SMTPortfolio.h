@@ -34,6 +34,8 @@ namespace solidity::smtutil
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * In racing mode the solvers are queried concurrently and the solvers with lower
+ * precedence are interrupted as soon as one of them answers the query.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -46,7 +48,14 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		bool _raceSolvers = false
+	);
+	/// Wraps the given solvers, used to test the portfolio with custom solvers.
+	SMTPortfolio(
+		std::vector<std::unique_ptr<SolverInterface>> _solvers,
+		std::optional<unsigned> _queryTimeout = {},
+		bool _raceSolvers = false
 	);
 
 	void reset() override;
@@ -59,15 +68,36 @@ public:
 	void addAssertion(Expression const& _expr) override;
 
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
+	void setQueryCache(std::shared_ptr<QueryCache> _cache) override;
+
+	/// @returns the variables declared since the last reset, in the order of their declaration.
+	std::vector<std::pair<std::string, SortPointer>> const& declarations() const { return m_declarations; }
 private:
+	/// Runs every solver on its own thread. Once a solver answers, the solvers after it
+	/// in m_solvers are interrupted.
+	/// @returns the results in the order of m_solvers.
+	std::vector<std::pair<CheckResult, std::vector<std::string>>> raceSolvers(
+		std::vector<Expression> const& _expressionsToEvaluate
+	);
+
+	/// Merges the result of the next solver into @a _result and @a _values.
+	/// @returns false if the result is CONFLICTING and no further solvers need to be considered.
+	static bool mergeResult(
+		CheckResult& _result,
+		std::vector<std::string>& _values,
+		std::pair<CheckResult, std::vector<std::string>> _solverResult
+	);
 	static bool solverAnswered(CheckResult result);
 
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	bool m_raceSolvers = false;
 
 	std::vector<Expression> m_assertions;
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
 };
 
 }
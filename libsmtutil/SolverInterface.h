@@ -503,6 +503,8 @@ private:
 
 DEV_SIMPLE_EXCEPTION(SolverError);
 
+class QueryCache;
+
 class SolverInterface
 {
 public:
@@ -530,14 +532,24 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a call to check() that is running on a different thread to stop early.
+	/// The interrupted call reports UNKNOWN or ERROR. Solvers that cannot be interrupted
+	/// ignore the request and run until their own time or resource limit is hit.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
 	/// @returns how many SMT solvers this interface has.
 	virtual size_t solvers() { return 1; }
 
+	/// Sets a persistent cache, which is consulted before solving a query
+	/// and which stores definitive answers.
+	virtual void setQueryCache(std::shared_ptr<QueryCache> _cache) { m_queryCache = std::move(_cache); }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
+	std::shared_ptr<QueryCache> m_queryCache;
 };
 
 }
@@ -18,6 +18,8 @@
 
 #include <libsmtutil/Z3CHCInterface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/CommonIO.h>
 
 #include <set>
@@ -51,6 +53,28 @@ Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout):
 	setSpacerOptions();
 }
 
+unique_ptr<Z3CHCInterface> Z3CHCInterface::copy() const
+{
+	auto result = make_unique<Z3CHCInterface>(m_queryTimeout);
+	z3::context& context = *result->m_context;
+	result->m_z3Interface->copyDeclarations(*m_z3Interface);
+	for (z3::func_decl const& relation: m_relations)
+	{
+		Z3_ast translated = Z3_translate(*m_context, Z3_func_decl_to_ast(*m_context, relation), context);
+		result->m_relations.emplace_back(context, Z3_to_func_decl(context, translated));
+		result->m_solver.register_relation(result->m_relations.back());
+	}
+	for (auto const& [rule, name]: m_rules)
+	{
+		z3::expr translated(context, Z3_translate(*m_context, rule, context));
+		result->m_solver.add_rule(translated, context.str_symbol(name.c_str()));
+		result->m_rules.emplace_back(translated, name);
+	}
+	result->setSpacerOptions(m_preProcessing);
+	result->m_queryCache = m_queryCache;
+	return result;
+}
+
 void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
@@ -59,14 +83,18 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
-	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
+	m_relations.emplace_back(m_z3Interface->functions().at(_expr.name));
+	m_solver.register_relation(m_relations.back());
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 {
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
 	if (m_z3Interface->constants().empty())
+	{
 		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
+		m_rules.emplace_back(rule, _name);
+	}
 	else
 	{
 		z3::expr_vector variables(*m_context);
@@ -74,10 +102,32 @@ void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 			variables.push_back(var.second);
 		z3::expr boundRule = z3::forall(variables, rule);
 		m_solver.add_rule(boundRule, m_context->str_symbol(_name.c_str()));
+		m_rules.emplace_back(boundRule, _name);
 	}
 }
 
 tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression const& _expr)
+{
+	if (!m_queryCache)
+		return solve(_expr);
+
+	// The preprocessing options change the shape of the counterexamples.
+	util::h256 cacheKey = QueryCache::key(
+		Z3Interface::version() + (m_preProcessing ? " spacer" : " spacer without preprocessing"),
+		m_solver.to_string() + "\n" + m_z3Interface->toZ3Expr(_expr).to_string()
+	);
+	if (optional<string> response = m_queryCache->load(cacheKey))
+		if (auto cachedResult = QueryCache::decodeQueryResult(*response))
+			return std::move(*cachedResult);
+
+	auto result = solve(_expr);
+	auto const& [checkResult, invariant, cex] = result;
+	if (checkResult == CheckResult::SATISFIABLE || checkResult == CheckResult::UNSATISFIABLE)
+		m_queryCache->store(cacheKey, QueryCache::encode(checkResult, invariant, cex));
+	return result;
+}
+
+tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::solve(Expression const& _expr)
 {
 	CheckResult result;
 	try
@@ -149,6 +199,7 @@ void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 	p.set("fp.xform.inline_eager", _preProcessing);
 
 	m_solver.set(p);
+	m_preProcessing = _preProcessing;
 }
 
 /**
@@ -36,6 +36,11 @@ class Z3CHCInterface: public CHCSolverInterface
 public:
 	Z3CHCInterface(std::optional<unsigned> _queryTimeout = {});
 
+	/// @returns an interface with the same declarations, relations, rules and options
+	/// in a separate z3 context, so that it can be queried concurrently with this one.
+	/// This interface must not be used by another thread while it is copied.
+	std::unique_ptr<Z3CHCInterface> copy() const;
+
 	/// Forwards variable declaration to Z3Interface.
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
 
@@ -50,6 +55,9 @@ public:
 	void setSpacerOptions(bool _preProcessing = true);
 
 private:
+	/// Runs @a _expr through the solver without consulting the query cache.
+	std::tuple<CheckResult, Expression, CexGraph> solve(Expression const& _expr);
+
 	/// Constructs a nonlinear counterexample graph from the refutation.
 	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof);
 	/// @returns the fact from a proof node.
@@ -65,8 +73,12 @@ private:
 	z3::context* m_context;
 	// Horn solver.
 	z3::fixedpoint m_solver;
+	/// The relations and rules given to m_solver, which does not provide access to them.
+	std::vector<z3::func_decl> m_relations;
+	std::vector<std::pair<z3::expr, std::string>> m_rules;
 
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
+	bool m_preProcessing = true;
 };
 
 }
@@ -18,6 +18,8 @@
 
 #include <libsmtutil/Z3Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
@@ -39,6 +41,16 @@ bool Z3Interface::available()
 #endif
 }
 
+string Z3Interface::version()
+{
+	unsigned major = 0;
+	unsigned minor = 0;
+	unsigned build = 0;
+	unsigned revision = 0;
+	Z3_get_version(&major, &minor, &build, &revision);
+	return "z3 " + to_string(major) + "." + to_string(minor) + "." + to_string(build) + "." + to_string(revision);
+}
+
 Z3Interface::Z3Interface(std::optional<unsigned> _queryTimeout):
 	SolverInterface(_queryTimeout),
 	m_solver(m_context)
@@ -90,6 +102,17 @@ void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
 		m_functions.emplace(_name, m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain)));
 }
 
+void Z3Interface::copyDeclarations(Z3Interface const& _other)
+{
+	for (auto const& [name, constant]: _other.m_constants)
+		m_constants.insert_or_assign(name, z3::expr(m_context, Z3_translate(_other.m_context, constant, m_context)));
+	for (auto const& [name, function]: _other.m_functions)
+	{
+		Z3_ast translated = Z3_translate(_other.m_context, Z3_func_decl_to_ast(_other.m_context, function), m_context);
+		m_functions.insert_or_assign(name, z3::func_decl(m_context, Z3_to_func_decl(m_context, translated)));
+	}
+}
+
 void Z3Interface::addAssertion(Expression const& _expr)
 {
 	m_solver.add(toZ3Expr(_expr));
@@ -97,6 +120,18 @@ void Z3Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	optional<h256> cacheKey;
+	if (m_queryCache)
+	{
+		string query = m_solver.to_smt2();
+		for (Expression const& e: _expressionsToEvaluate)
+			query += "\n" + toZ3Expr(e).to_string();
+		cacheKey = QueryCache::key(version(), query);
+		if (optional<string> response = m_queryCache->load(*cacheKey))
+			if (auto cachedResult = QueryCache::decodeCheckResult(*response))
+				return *cachedResult;
+	}
+
 	CheckResult result;
 	vector<string> values;
 	try
@@ -137,9 +172,18 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 		values.clear();
 	}
 
+	if (cacheKey && (result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE))
+		m_queryCache->store(*cacheKey, QueryCache::encode(result, values));
 	return make_pair(result, values);
 }
 
+void Z3Interface::interrupt()
+{
+	// Only has an effect while the solver is running. The interrupted check
+	// fails with "canceled" and is reported as UNKNOWN.
+	m_context.interrupt();
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
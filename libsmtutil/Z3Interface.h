@@ -34,6 +34,8 @@ public:
 	Z3Interface(std::optional<unsigned> _queryTimeout = {});
 
 	static bool available();
+	/// @returns the name and version of the z3 library in use.
+	static std::string version();
 
 	void reset() override;
 
@@ -44,6 +46,7 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
@@ -53,6 +56,9 @@ public:
 
 	z3::context* context() { return &m_context; }
 
+	/// Translates the declarations of @a _other into the context of this interface.
+	void copyDeclarations(Z3Interface const& _other);
+
 	// Z3 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	static int const resourceLimit = 1000000;
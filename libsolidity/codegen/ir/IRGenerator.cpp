@@ -87,7 +87,7 @@ set<CallableDeclaration const*, ASTNode::CompareByID> collectReachableCallables(
 
 }
 
-pair<string, string> IRGenerator::run(
+pair<string, shared_ptr<yul::YulStack>> IRGenerator::run(
 	ContractDefinition const& _contract,
 	bytes const& _cborMetadata,
 	map<ContractDefinition const*, string_view const> const& _otherYulSources
@@ -95,26 +95,27 @@ pair<string, string> IRGenerator::run(
 {
 	string ir = yul::reindent(generate(_contract, _cborMetadata, _otherYulSources));
 
-	yul::YulStack asmStack(
+	auto asmStack = make_shared<yul::YulStack>(
 		m_evmVersion,
 		m_eofVersion,
 		yul::YulStack::Language::StrictAssembly,
 		m_optimiserSettings,
-		m_context.debugInfoSelection()
+		m_context.debugInfoSelection(),
+		m_optimizationCache
 	);
-	if (!asmStack.parseAndAnalyze("", ir))
+	if (!asmStack->parseAndAnalyze("", ir))
 	{
 		string errorMessage;
-		for (auto const& error: asmStack.errors())
+		for (auto const& error: asmStack->errors())
 			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(
 				*error,
-				asmStack.charStream("")
+				asmStack->charStream("")
 			);
 		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
-	asmStack.optimize();
+	asmStack->optimize();
 
-	return {std::move(ir), asmStack.print(m_context.soliditySourceProvider())};
+	return {std::move(ir), std::move(asmStack)};
 }
 
 string IRGenerator::generate(
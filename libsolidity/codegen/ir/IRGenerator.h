@@ -32,8 +32,15 @@
 #include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <memory>
 #include <string>
 
+namespace solidity::yul
+{
+class ObjectOptimizationCache;
+class YulStack;
+}
+
 namespace solidity::frontend
 {
 
@@ -51,11 +58,13 @@ public:
 		OptimiserSettings _optimiserSettings,
 		std::map<std::string, unsigned> _sourceIndices,
 		langutil::DebugInfoSelection const& _debugInfoSelection,
-		langutil::CharStreamProvider const* _soliditySourceProvider
+		langutil::CharStreamProvider const* _soliditySourceProvider,
+		std::shared_ptr<yul::ObjectOptimizationCache> _optimizationCache = nullptr
 	):
 		m_evmVersion(_evmVersion),
 		m_eofVersion(_eofVersion),
 		m_optimiserSettings(_optimiserSettings),
+		m_optimizationCache(std::move(_optimizationCache)),
 		m_context(
 			_evmVersion,
 			ExecutionContext::Creation,
@@ -68,9 +77,10 @@ public:
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(
+	/// Generates and returns the unoptimized IR code together with the stack holding its
+	/// parsed and analyzed form, which is already optimized if the optimizer settings say so.
+	/// The stack can be used for EVM code generation without re-parsing the code.
+	std::pair<std::string, std::shared_ptr<yul::YulStack>> run(
 		ContractDefinition const& _contract,
 		bytes const& _cborMetadata,
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
@@ -142,6 +152,9 @@ private:
 	langutil::EVMVersion const m_evmVersion;
 	std::optional<uint8_t> const m_eofVersion;
 	OptimiserSettings const m_optimiserSettings;
+	/// Shared with the IR generators of the other contracts of the compilation, so that
+	/// the code of created contracts is not optimized again where it is embedded.
+	std::shared_ptr<yul::ObjectOptimizationCache> m_optimizationCache;
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
@@ -21,6 +21,7 @@
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/formal/SymbolicTypes.h>
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SMTPortfolio.h>
 
 #include <liblangutil/CharStream.h>
@@ -30,6 +31,9 @@
 #include <z3_version.h>
 #endif
 
+#include <atomic>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -45,8 +49,10 @@ BMC::BMC(
 	CharStreamProvider const& _charStreamProvider
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _settings.solvers, _settings.timeout))
+	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _settings.solvers, _settings.timeout, _settings.raceSolvers))
 {
+	if (!m_settings.cacheDir.empty())
+		m_interface->setQueryCache(make_shared<smtutil::QueryCache>(m_settings.cacheDir));
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (m_settings.solvers.cvc4 || m_settings.solvers.z3)
 		if (!_smtlib2Responses.empty())
@@ -84,9 +90,18 @@ void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<Verificatio
 	createFreeConstants(sourceDependencies(_source));
 	state().prepareForSourceUnit(_source);
 	m_unprovedAmt = 0;
+	// The solvers behind the SMT-LIB2 callback answer one query at a time.
+	m_checkConcurrently = m_settings.jobs > 1 && !m_settings.solvers.smtlib2;
+	m_constantConditionTargets.clear();
+	m_deferredTargets.clear();
 
 	_source.accept(*this);
 
+	if (!m_constantConditionTargets.empty())
+		checkVerificationTargets();
+	if (m_checkConcurrently)
+		checkDeferredTargets();
+
 	if (m_unprovedAmt > 0 && !m_settings.showUnproved)
 		m_errorReporter.warning(
 			2788_error,
@@ -694,46 +709,178 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 
 /// Verification targets.
 
+BMC::Checker BMC::checker()
+{
+	return {
+		*m_interface,
+		m_errorReporter,
+		m_loopExecutionHappened,
+		m_externalFunctionCallHappened,
+		SMTEncoder::extraComment()
+	};
+}
+
 void BMC::checkVerificationTargets()
 {
+	if (m_checkConcurrently)
+	{
+		// Constant conditions come first because they are otherwise checked while encoding.
+		FunctionTargets function{
+			std::move(m_constantConditionTargets),
+			m_interface->declarations().size(),
+			m_loopExecutionHappened,
+			m_externalFunctionCallHappened,
+			SMTEncoder::extraComment()
+		};
+		m_constantConditionTargets.clear();
+		for (auto& target: m_verificationTargets)
+			function.targets.emplace_back(std::move(target));
+		m_deferredTargets.emplace_back(std::move(function));
+		return;
+	}
+
+	Checker mainChecker = checker();
 	for (auto& target: m_verificationTargets)
-		checkVerificationTarget(target);
+		checkVerificationTarget(target, mainChecker);
+	m_unprovedAmt += mainChecker.unprovedAmt;
+}
+
+namespace
+{
+
+/// Adds the names of all variables and functions @a _expr refers to to @a _names.
+void collectNames(smtutil::Expression const& _expr, set<string>& _names)
+{
+	_names.insert(_expr.name);
+	for (auto const& argument: _expr.arguments)
+		collectNames(argument, _names);
+}
+
 }
 
-void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
+void BMC::checkDeferredTargets()
+{
+	vector<unique_ptr<UniqueErrorReporter>> errorReporters(m_deferredTargets.size());
+	vector<size_t> unprovedAmts(m_deferredTargets.size(), 0);
+	vector<exception_ptr> exceptions(m_deferredTargets.size());
+	atomic<size_t> nextFunction{0};
+	auto check = [&]() {
+		for (size_t index = nextFunction++; index < m_deferredTargets.size(); index = nextFunction++)
+			try
+			{
+				FunctionTargets& function = m_deferredTargets[index];
+				// Every function gets a fresh solver with the variables that were declared
+				// when the function was encoded, as if it had been checked right away.
+				// Only the ones its targets refer to are declared, so that the work per function
+				// does not grow with the number of variables of the functions encoded before it.
+				set<string> usedNames;
+				for (auto const& target: function.targets)
+				{
+					collectNames(target.constraints, usedNames);
+					collectNames(target.value, usedNames);
+					for (auto const& modelExpression: target.modelExpressions.first)
+						collectNames(modelExpression, usedNames);
+				}
+				smtutil::SMTPortfolio solver({}, {}, m_settings.solvers, m_settings.timeout, m_settings.raceSolvers);
+				if (!m_settings.cacheDir.empty())
+					solver.setQueryCache(make_shared<smtutil::QueryCache>(m_settings.cacheDir));
+				auto const& declarations = m_interface->declarations();
+				for (size_t i = 0; i < function.declarations; ++i)
+					if (usedNames.count(declarations[i].first))
+						solver.declareVariable(declarations[i].first, declarations[i].second);
+
+				errorReporters[index] = make_unique<UniqueErrorReporter>();
+				Checker functionChecker{
+					solver,
+					*errorReporters[index],
+					function.loopExecutionHappened,
+					function.externalFunctionCallHappened,
+					function.extraComment
+				};
+				for (auto& target: function.targets)
+					checkVerificationTarget(target, functionChecker);
+				unprovedAmts[index] = functionChecker.unprovedAmt;
+			}
+			catch (...)
+			{
+				exceptions[index] = current_exception();
+			}
+	};
+
+	vector<thread> threads;
+	size_t const threadCount = min<size_t>(m_settings.jobs, m_deferredTargets.size());
+	while (threads.size() + 1 < threadCount)
+		try
+		{
+			threads.emplace_back(check);
+		}
+		catch (system_error const&)
+		{
+			// Continue with the threads we already have.
+			break;
+		}
+	check();
+	for (thread& checkThread: threads)
+		checkThread.join();
+
+	for (size_t index = 0; index < m_deferredTargets.size(); ++index)
+	{
+		if (exceptions[index])
+			rethrow_exception(exceptions[index]);
+		for (auto const& error: errorReporters[index]->errors())
+		{
+			solAssert(error->type() == Error::Type::Warning);
+			solAssert(error->comment());
+			if (error->sourceLocation() && error->sourceLocation()->isValid())
+				m_errorReporter.warning(
+					error->errorId(),
+					*error->sourceLocation(),
+					*error->comment(),
+					error->secondarySourceLocation() ? *error->secondarySourceLocation() : SecondarySourceLocation{}
+				);
+			else
+				m_errorReporter.warning(error->errorId(), *error->comment());
+		}
+		m_unprovedAmt += unprovedAmts[index];
+	}
+	m_deferredTargets.clear();
+}
+
+void BMC::checkVerificationTarget(BMCVerificationTarget& _target, Checker& _checker)
 {
 	switch (_target.type)
 	{
 		case VerificationTargetType::ConstantCondition:
-			checkConstantCondition(_target);
+			checkConstantCondition(_target, _checker);
 			break;
 		case VerificationTargetType::Underflow:
-			checkUnderflow(_target);
+			checkUnderflow(_target, _checker);
 			break;
 		case VerificationTargetType::Overflow:
-			checkOverflow(_target);
+			checkOverflow(_target, _checker);
 			break;
 		case VerificationTargetType::UnderOverflow:
-			checkUnderflow(_target);
-			checkOverflow(_target);
+			checkUnderflow(_target, _checker);
+			checkOverflow(_target, _checker);
 			break;
 		case VerificationTargetType::DivByZero:
-			checkDivByZero(_target);
+			checkDivByZero(_target, _checker);
 			break;
 		case VerificationTargetType::Balance:
-			checkBalance(_target);
+			checkBalance(_target, _checker);
 			break;
 		case VerificationTargetType::Assert:
-			checkAssert(_target);
+			checkAssert(_target, _checker);
 			break;
 		default:
 			solAssert(false, "");
 	}
 }
 
-void BMC::checkConstantCondition(BMCVerificationTarget& _target)
+void BMC::checkConstantCondition(BMCVerificationTarget& _target, Checker& _checker)
 {
 	checkBooleanNotConstant(
+		_checker,
 		*_target.expression,
 		_target.constraints,
 		_target.value,
@@ -741,7 +888,7 @@ void BMC::checkConstantCondition(BMCVerificationTarget& _target)
 	);
 }
 
-void BMC::checkUnderflow(BMCVerificationTarget& _target)
+void BMC::checkUnderflow(BMCVerificationTarget& _target, Checker& _checker)
 {
 	solAssert(
 		_target.type == VerificationTargetType::Underflow ||
@@ -762,6 +909,7 @@ void BMC::checkUnderflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
+		_checker,
 		_target.constraints && _target.value < smt::minValue(*intType),
 		_target.callStack,
 		_target.modelExpressions,
@@ -774,7 +922,7 @@ void BMC::checkUnderflow(BMCVerificationTarget& _target)
 	);
 }
 
-void BMC::checkOverflow(BMCVerificationTarget& _target)
+void BMC::checkOverflow(BMCVerificationTarget& _target, Checker& _checker)
 {
 	solAssert(
 		_target.type == VerificationTargetType::Overflow ||
@@ -795,6 +943,7 @@ void BMC::checkOverflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
+		_checker,
 		_target.constraints && _target.value > smt::maxValue(*intType),
 		_target.callStack,
 		_target.modelExpressions,
@@ -807,7 +956,7 @@ void BMC::checkOverflow(BMCVerificationTarget& _target)
 	);
 }
 
-void BMC::checkDivByZero(BMCVerificationTarget& _target)
+void BMC::checkDivByZero(BMCVerificationTarget& _target, Checker& _checker)
 {
 	solAssert(_target.type == VerificationTargetType::DivByZero, "");
 
@@ -818,6 +967,7 @@ void BMC::checkDivByZero(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
+		_checker,
 		_target.constraints && (_target.value == 0),
 		_target.callStack,
 		_target.modelExpressions,
@@ -830,10 +980,11 @@ void BMC::checkDivByZero(BMCVerificationTarget& _target)
 	);
 }
 
-void BMC::checkBalance(BMCVerificationTarget& _target)
+void BMC::checkBalance(BMCVerificationTarget& _target, Checker& _checker)
 {
 	solAssert(_target.type == VerificationTargetType::Balance, "");
 	checkCondition(
+		_checker,
 		_target.constraints && _target.value,
 		_target.callStack,
 		_target.modelExpressions,
@@ -845,7 +996,7 @@ void BMC::checkBalance(BMCVerificationTarget& _target)
 	);
 }
 
-void BMC::checkAssert(BMCVerificationTarget& _target)
+void BMC::checkAssert(BMCVerificationTarget& _target, Checker& _checker)
 {
 	solAssert(_target.type == VerificationTargetType::Assert, "");
 
@@ -856,6 +1007,7 @@ void BMC::checkAssert(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
+		_checker,
 		_target.constraints && !_target.value,
 		_target.callStack,
 		_target.modelExpressions,
@@ -885,8 +1037,14 @@ void BMC::addVerificationTarget(
 		m_callStack,
 		modelExpressions()
 	};
-	if (_type == VerificationTargetType::ConstantCondition)
-		checkVerificationTarget(target);
+	if (_type == VerificationTargetType::ConstantCondition && m_checkConcurrently)
+		m_constantConditionTargets.emplace_back(std::move(target));
+	else if (_type == VerificationTargetType::ConstantCondition)
+	{
+		Checker mainChecker = checker();
+		checkVerificationTarget(target, mainChecker);
+		m_unprovedAmt += mainChecker.unprovedAmt;
+	}
 	else
 		m_verificationTargets.emplace_back(std::move(target));
 }
@@ -894,6 +1052,7 @@ void BMC::addVerificationTarget(
 /// Solving.
 
 void BMC::checkCondition(
+	Checker& _checker,
 	smtutil::Expression _condition,
 	vector<SMTEncoder::CallStackEntry> const& _callStack,
 	pair<vector<smtutil::Expression>, vector<string>> const& _modelExpressions,
@@ -905,8 +1064,8 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
+	_checker.solver.push();
+	_checker.solver.addAssertion(_condition);
 
 	vector<smtutil::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
@@ -919,14 +1078,14 @@ void BMC::checkCondition(
 		}
 	smtutil::CheckResult result;
 	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	tie(result, values) = checkSatisfiableAndGenerateModel(_checker, expressionsToEvaluate);
 
-	string extraComment = SMTEncoder::extraComment();
-	if (m_loopExecutionHappened)
+	string extraComment = _checker.extraComment;
+	if (_checker.loopExecutionHappened)
 		extraComment +=
 			"\nNote that some information is erased after the execution of loops.\n"
 			"You can re-introduce information using require().";
-	if (m_externalFunctionCallHappened)
+	if (_checker.externalFunctionCallHappened)
 		extraComment +=
 			"\nNote that external function calls are not inlined,"
 			" even if the source code of the function is available."
@@ -958,7 +1117,7 @@ void BMC::checkCondition(
 				modelMessage << "  " << eval.first << " = " << eval.second << "\n";
 		}
 
-		m_errorReporter.warning(
+		_checker.errorReporter.warning(
 			_errorHappens,
 			_location,
 			message.str(),
@@ -972,23 +1131,24 @@ void BMC::checkCondition(
 		break;
 	case smtutil::CheckResult::UNKNOWN:
 	{
-		++m_unprovedAmt;
+		++_checker.unprovedAmt;
 		if (m_settings.showUnproved)
-			m_errorReporter.warning(_errorMightHappen, _location, "BMC: " + _description + " might happen here.", secondaryLocation);
+			_checker.errorReporter.warning(_errorMightHappen, _location, "BMC: " + _description + " might happen here.", secondaryLocation);
 		break;
 	}
 	case smtutil::CheckResult::CONFLICTING:
-		m_errorReporter.warning(1584_error, _location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		_checker.errorReporter.warning(1584_error, _location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
 		break;
 	case smtutil::CheckResult::ERROR:
-		m_errorReporter.warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
+		_checker.errorReporter.warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
 		break;
 	}
 
-	m_interface->pop();
+	_checker.solver.pop();
 }
 
 void BMC::checkBooleanNotConstant(
+	Checker& _checker,
 	Expression const& _condition,
 	smtutil::Expression const& _constraints,
 	smtutil::Expression const& _value,
@@ -999,20 +1159,20 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && _value);
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
+	_checker.solver.push();
+	_checker.solver.addAssertion(_constraints && _value);
+	auto positiveResult = checkSatisfiable(_checker);
+	_checker.solver.pop();
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && !_value);
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+	_checker.solver.push();
+	_checker.solver.addAssertion(_constraints && !_value);
+	auto negatedResult = checkSatisfiable(_checker);
+	_checker.solver.pop();
 
 	if (positiveResult == smtutil::CheckResult::ERROR || negatedResult == smtutil::CheckResult::ERROR)
-		m_errorReporter.warning(8592_error, _condition.location(), "BMC: Error trying to invoke SMT solver.");
+		_checker.errorReporter.warning(8592_error, _condition.location(), "BMC: Error trying to invoke SMT solver.");
 	else if (positiveResult == smtutil::CheckResult::CONFLICTING || negatedResult == smtutil::CheckResult::CONFLICTING)
-		m_errorReporter.warning(3356_error, _condition.location(), "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		_checker.errorReporter.warning(3356_error, _condition.location(), "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
 	else if (positiveResult == smtutil::CheckResult::SATISFIABLE && negatedResult == smtutil::CheckResult::SATISFIABLE)
 	{
 		// everything fine.
@@ -1022,7 +1182,7 @@ void BMC::checkBooleanNotConstant(
 		// can't do anything.
 	}
 	else if (positiveResult == smtutil::CheckResult::UNSATISFIABLE && negatedResult == smtutil::CheckResult::UNSATISFIABLE)
-		m_errorReporter.warning(2512_error, _condition.location(), "BMC: Condition unreachable.", SMTEncoder::callStackMessage(_callStack));
+		_checker.errorReporter.warning(2512_error, _condition.location(), "BMC: Condition unreachable.", SMTEncoder::callStackMessage(_callStack));
 	else
 	{
 		string description;
@@ -1037,7 +1197,7 @@ void BMC::checkBooleanNotConstant(
 			solAssert(negatedResult == smtutil::CheckResult::SATISFIABLE, "");
 			description = "BMC: Condition is always false.";
 		}
-		m_errorReporter.warning(
+		_checker.errorReporter.warning(
 			6838_error,
 			_condition.location(),
 			description,
@@ -1047,20 +1207,20 @@ void BMC::checkBooleanNotConstant(
 }
 
 pair<smtutil::CheckResult, vector<string>>
-BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expressionsToEvaluate)
+BMC::checkSatisfiableAndGenerateModel(Checker& _checker, vector<smtutil::Expression> const& _expressionsToEvaluate)
 {
 	smtutil::CheckResult result;
 	vector<string> values;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		tie(result, values) = _checker.solver.check(_expressionsToEvaluate);
 	}
 	catch (smtutil::SolverError const& _e)
 	{
 		string description("BMC: Error querying SMT solver");
 		if (_e.comment())
 			description += ": " + *_e.comment();
-		m_errorReporter.warning(8140_error, description);
+		_checker.errorReporter.warning(8140_error, description);
 		result = smtutil::CheckResult::ERROR;
 	}
 
@@ -1077,9 +1237,9 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 	return make_pair(result, values);
 }
 
-smtutil::CheckResult BMC::checkSatisfiable()
+smtutil::CheckResult BMC::checkSatisfiable(Checker& _checker)
 {
-	return checkSatisfiableAndGenerateModel({}).first;
+	return checkSatisfiableAndGenerateModel(_checker, {}).first;
 }
 
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
@@ -35,7 +35,7 @@
 
 #include <libsolidity/interface/ReadFile.h>
 
-#include <libsmtutil/SolverInterface.h>
+#include <libsmtutil/SMTPortfolio.h>
 #include <liblangutil/UniqueErrorReporter.h>
 
 #include <set>
@@ -137,14 +137,43 @@ private:
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> modelExpressions;
 	};
 
+	/// The solver that checks the targets and the destination of the resulting diagnostics.
+	/// When targets are checked concurrently, every function gets its own.
+	struct Checker
+	{
+		smtutil::SolverInterface& solver;
+		langutil::UniqueErrorReporter& errorReporter;
+		/// Flags used for better warning messages.
+		bool loopExecutionHappened = false;
+		bool externalFunctionCallHappened = false;
+		std::string extraComment;
+		/// Number of verification conditions that could not be proved.
+		size_t unprovedAmt = 0;
+	};
+	/// The targets of a function, checked after the whole source unit has been encoded.
+	struct FunctionTargets
+	{
+		std::vector<BMCVerificationTarget> targets;
+		/// Number of variables of m_interface that were declared when the function was encoded.
+		size_t declarations = 0;
+		bool loopExecutionHappened = false;
+		bool externalFunctionCallHappened = false;
+		std::string extraComment;
+	};
+
+	/// @returns a checker that uses m_interface and m_errorReporter.
+	Checker checker();
 	void checkVerificationTargets();
-	void checkVerificationTarget(BMCVerificationTarget& _target);
-	void checkConstantCondition(BMCVerificationTarget& _target);
-	void checkUnderflow(BMCVerificationTarget& _target);
-	void checkOverflow(BMCVerificationTarget& _target);
-	void checkDivByZero(BMCVerificationTarget& _target);
-	void checkBalance(BMCVerificationTarget& _target);
-	void checkAssert(BMCVerificationTarget& _target);
+	/// Checks m_deferredTargets using up to m_settings.jobs threads and
+	/// reports the diagnostics in the order the functions were encoded.
+	void checkDeferredTargets();
+	void checkVerificationTarget(BMCVerificationTarget& _target, Checker& _checker);
+	void checkConstantCondition(BMCVerificationTarget& _target, Checker& _checker);
+	void checkUnderflow(BMCVerificationTarget& _target, Checker& _checker);
+	void checkOverflow(BMCVerificationTarget& _target, Checker& _checker);
+	void checkDivByZero(BMCVerificationTarget& _target, Checker& _checker);
+	void checkBalance(BMCVerificationTarget& _target, Checker& _checker);
+	void checkAssert(BMCVerificationTarget& _target, Checker& _checker);
 	void addVerificationTarget(
 		VerificationTargetType _type,
 		smtutil::Expression const& _value,
@@ -156,6 +185,7 @@ private:
 	//@{
 	/// Check that a condition can be satisfied.
 	void checkCondition(
+		Checker& _checker,
 		smtutil::Expression _condition,
 		std::vector<CallStackEntry> const& _callStack,
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> const& _modelExpressions,
@@ -169,18 +199,19 @@ private:
 	/// Checks that a boolean condition is not constant. Do not warn if the expression
 	/// is a literal constant.
 	void checkBooleanNotConstant(
+		Checker& _checker,
 		Expression const& _condition,
 		smtutil::Expression const& _constraints,
 		smtutil::Expression const& _value,
 		std::vector<CallStackEntry> const& _callStack
 	);
 	std::pair<smtutil::CheckResult, std::vector<std::string>>
-	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	checkSatisfiableAndGenerateModel(Checker& _checker, std::vector<smtutil::Expression> const& _expressionsToEvaluate);
 
-	smtutil::CheckResult checkSatisfiable();
+	smtutil::CheckResult checkSatisfiable(Checker& _checker);
 	//@}
 
-	std::unique_ptr<smtutil::SolverInterface> m_interface;
+	std::unique_ptr<smtutil::SMTPortfolio> m_interface;
 
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
@@ -188,6 +219,12 @@ private:
 
 	std::vector<BMCVerificationTarget> m_verificationTargets;
 
+	/// Whether the targets are checked concurrently once the source unit has been encoded.
+	bool m_checkConcurrently = false;
+	/// Constant conditions of the current function, which are otherwise checked right away.
+	std::vector<BMCVerificationTarget> m_constantConditionTargets;
+	std::vector<FunctionTargets> m_deferredTargets;
+
 	/// Targets that were already proven.
 	std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> m_solvedTargets;
 
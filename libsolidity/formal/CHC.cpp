@@ -33,6 +33,7 @@
 #include <libsolidity/ast/TypeProvider.h>
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
+#include <libsmtutil/QueryCache.h>
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/StringUtils.h>
@@ -48,8 +49,10 @@
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/reverse.hpp>
 
+#include <atomic>
 #include <charconv>
 #include <queue>
+#include <thread>
 
 using namespace std;
 using namespace solidity;
@@ -71,6 +74,8 @@ CHC::CHC(
 	m_smtlib2Responses(_smtlib2Responses),
 	m_smtCallback(_smtCallback)
 {
+	if (!m_settings.cacheDir.empty())
+		m_queryCache = make_shared<smtutil::QueryCache>(m_settings.cacheDir);
 }
 
 void CHC::analyze(SourceUnit const& _source)
@@ -1022,6 +1027,7 @@ void CHC::resetSourceAnalysis()
 		smtlib2Interface->reset();
 		m_context.setSolver(smtlib2Interface->smtlib2Interface());
 	}
+	m_interface->setQueryCache(m_queryCache);
 
 	m_context.reset();
 	m_context.resetUniqueId();
@@ -1557,52 +1563,53 @@ void CHC::addRule(smtutil::Expression const& _rule, string const& _ruleName)
 }
 
 tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
+{
+	auto answer = solveQuery(*m_interface, _query);
+	reportQueryFailure(get<0>(answer), _location);
+	return answer;
+}
+
+tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::solveQuery(
+	CHCSolverInterface& _interface,
+	smtutil::Expression const& _query
+) const
 {
 	CheckResult result;
 	smtutil::Expression invariant(true);
 	CHCSolverInterface::CexGraph cex;
-	tie(result, invariant, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
-	{
+	tie(result, invariant, cex) = _interface.query(_query);
 	// We still need the ifdef because of Z3CHCInterface.
-		if (m_settings.solvers.z3)
-		{
+	if (result == CheckResult::SATISFIABLE && m_settings.solvers.z3)
+	{
 #ifdef HAVE_Z3
-			// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
-			// We now disable those optimizations and check whether we can still solve the problem.
-			auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
-			solAssert(spacer, "");
-			spacer->setSpacerOptions(false);
+		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
+		// We now disable those optimizations and check whether we can still solve the problem.
+		auto* spacer = dynamic_cast<Z3CHCInterface*>(&_interface);
+		solAssert(spacer, "");
+		spacer->setSpacerOptions(false);
 
-			CheckResult resultNoOpt;
-			smtutil::Expression invariantNoOpt(true);
-			CHCSolverInterface::CexGraph cexNoOpt;
-			tie(resultNoOpt, invariantNoOpt, cexNoOpt) = m_interface->query(_query);
+		CheckResult resultNoOpt;
+		smtutil::Expression invariantNoOpt(true);
+		CHCSolverInterface::CexGraph cexNoOpt;
+		tie(resultNoOpt, invariantNoOpt, cexNoOpt) = _interface.query(_query);
 
-			if (resultNoOpt == CheckResult::SATISFIABLE)
-				cex = std::move(cexNoOpt);
+		if (resultNoOpt == CheckResult::SATISFIABLE)
+			cex = std::move(cexNoOpt);
 
-			spacer->setSpacerOptions(true);
+		spacer->setSpacerOptions(true);
 #else
-			solAssert(false);
+		solAssert(false);
 #endif
-		}
-		break;
 	}
-	case CheckResult::UNSATISFIABLE:
-		break;
-	case CheckResult::UNKNOWN:
-		break;
-	case CheckResult::CONFLICTING:
+	return {result, invariant, cex};
+}
+
+void CHC::reportQueryFailure(CheckResult _result, langutil::SourceLocation const& _location)
+{
+	if (_result == CheckResult::CONFLICTING)
 		m_errorReporter.warning(1988_error, _location, "CHC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
-		break;
-	case CheckResult::ERROR:
+	else if (_result == CheckResult::ERROR)
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
-		break;
-	}
-	return {result, invariant, cex};
 }
 
 void CHC::verificationTargetEncountered(
@@ -1659,6 +1666,19 @@ void CHC::checkVerificationTargets()
 				targetEntryPoints[id].push_back(placeholder);
 	}
 
+#ifdef HAVE_Z3
+	// With several jobs and z3, the targets are solved concurrently on copies of the z3 context
+	// and are therefore all encoded before solving. Otherwise, each target is encoded right
+	// before it is queried, so that its query only sees the error blocks of earlier targets.
+	// The other solvers are driven through a callback that cannot be used concurrently.
+	bool const encodeTargetsFirst =
+		m_settings.jobs > 1 &&
+		m_settings.solvers.z3 &&
+		dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+#else
+	bool const encodeTargetsFirst = false;
+#endif
+	vector<CHCTargetCheck> checks;
 	set<unsigned> checkedErrorIds;
 	for (auto const& [targetId, placeholders]: targetEntryPoints)
 	{
@@ -1714,9 +1734,14 @@ void CHC::checkVerificationTargets()
 		else
 			solAssert(false, "");
 
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		if (encodeTargetsFirst)
+			checks.push_back({target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here."});
+		else
+			checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
 		checkedErrorIds.insert(target.errorId);
 	}
+	if (!checks.empty())
+		checkAndReportTargets(checks);
 
 	auto toReport = m_unsafeTargets;
 	if (m_settings.showUnproved)
@@ -1813,9 +1838,99 @@ void CHC::checkAndReportTarget(
 	string _unknownMsg
 )
 {
-	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
+	if (isUnsafe(_target))
+		return;
+
+	smtutil::Expression const errorPredicate = encodeTarget(_target, _placeholders);
+	reportTarget(
+		{_target, _placeholders, _errorReporterId, std::move(_satMsg), std::move(_unknownMsg)},
+		errorPredicate.name,
+		query(errorPredicate, _target.errorNode->location())
+	);
+}
+
+void CHC::checkAndReportTargets(vector<CHCTargetCheck> const& _checks)
+{
+	// All error blocks are added before solving, so every query sees the same rules
+	// no matter how the queries are distributed over the jobs.
+	vector<smtutil::Expression> queries;
+	for (auto const& check: _checks)
+		queries.emplace_back(encodeTarget(check.target, check.placeholders));
+
+	size_t const jobs = min<size_t>(m_settings.jobs, queries.size());
+	if (jobs <= 1)
+	{
+		for (size_t index = 0; index < _checks.size(); ++index)
+			if (!isUnsafe(_checks[index].target))
+				reportTarget(
+					_checks[index],
+					queries[index].name,
+					query(queries[index], _checks[index].target.errorNode->location())
+				);
 		return;
+	}
+
+#ifdef HAVE_Z3
+	auto const* spacer = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+	solAssert(spacer);
+
+	// Every additional job solves on its own copy of the Horn solver, the calling thread
+	// uses the original. The copies are made before solving starts, because the
+	// original context must not be used by several threads at once.
+	vector<unique_ptr<Z3CHCInterface>> copies;
+	for (size_t job = 1; job < jobs; ++job)
+		copies.emplace_back(spacer->copy());
+
+	using Answer = tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph>;
+	vector<optional<Answer>> answers(queries.size());
+	vector<exception_ptr> exceptions(queries.size());
+	atomic<size_t> nextQuery{0};
+	auto solve = [&](CHCSolverInterface& _solver) {
+		for (size_t index = nextQuery++; index < queries.size(); index = nextQuery++)
+			try
+			{
+				answers[index] = solveQuery(_solver, queries[index]);
+			}
+			catch (...)
+			{
+				exceptions[index] = current_exception();
+			}
+	};
+
+	vector<thread> threads;
+	for (auto const& solverCopy: copies)
+		try
+		{
+			threads.emplace_back(solve, ref(*solverCopy));
+		}
+		catch (system_error const&)
+		{
+			// Continue with the threads we already have.
+			break;
+		}
+	solve(*m_interface);
+	for (thread& solver: threads)
+		solver.join();
+
+	for (size_t index = 0; index < _checks.size(); ++index)
+	{
+		if (exceptions[index])
+			rethrow_exception(exceptions[index]);
+		auto const& check = _checks[index];
+		// Same as in the sequential mode, a target is only reported once.
+		if (isUnsafe(check.target))
+			continue;
+		solAssert(answers[index]);
+		reportQueryFailure(get<0>(*answers[index]), check.target.errorNode->location());
+		reportTarget(check, queries[index].name, *answers[index]);
+	}
+#else
+	solAssert(false, "Targets are only solved concurrently with z3.");
+#endif
+}
 
+smtutil::Expression CHC::encodeTarget(CHCVerificationTarget const& _target, vector<CHCQueryPlaceholder> const& _placeholders)
+{
 	createErrorBlock();
 	for (auto const& placeholder: _placeholders)
 		connectBlocks(
@@ -1823,11 +1938,26 @@ void CHC::checkAndReportTarget(
 			error(),
 			placeholder.constraints && placeholder.errorExpression == _target.errorId
 		);
-	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
+	return error();
+}
+
+bool CHC::isUnsafe(CHCVerificationTarget const& _target) const
+{
+	return m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type);
+}
+
+void CHC::reportTarget(
+	CHCTargetCheck const& _check,
+	string const& _errorPredicate,
+	tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> const& _answer
+)
+{
+	auto const& [result, invariant, model] = _answer;
+	auto const& target = _check.target;
+	auto const& location = target.errorNode->location();
 	if (result == CheckResult::UNSATISFIABLE)
 	{
-		m_safeTargets[_target.errorNode].insert(_target.type);
+		m_safeTargets[target.errorNode].insert(target.type);
 		set<Predicate const*> predicates;
 		for (auto const* pred: m_interfaces | ranges::views::values)
 			predicates.insert(pred);
@@ -1839,26 +1969,26 @@ void CHC::checkAndReportTarget(
 	}
 	else if (result == CheckResult::SATISFIABLE)
 	{
-		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
+		solAssert(!_check.satMsg.empty(), "");
+		auto cex = generateCounterexample(model, _errorPredicate);
 		if (cex)
-			m_unsafeTargets[_target.errorNode][_target.type] = {
-				_errorReporterId,
+			m_unsafeTargets[target.errorNode][target.type] = {
+				_check.errorReporterId,
 				location,
-				"CHC: " + _satMsg + "\nCounterexample:\n" + *cex
+				"CHC: " + _check.satMsg + "\nCounterexample:\n" + *cex
 			};
 		else
-			m_unsafeTargets[_target.errorNode][_target.type] = {
-				_errorReporterId,
+			m_unsafeTargets[target.errorNode][target.type] = {
+				_check.errorReporterId,
 				location,
-				"CHC: " + _satMsg
+				"CHC: " + _check.satMsg
 			};
 	}
-	else if (!_unknownMsg.empty())
-		m_unprovedTargets[_target.errorNode][_target.type] = {
-			_errorReporterId,
+	else if (!_check.unknownMsg.empty())
+		m_unprovedTargets[target.errorNode][target.type] = {
+			_check.errorReporterId,
 			location,
-			"CHC: " + _unknownMsg
+			"CHC: " + _check.unknownMsg
 		};
 }
 
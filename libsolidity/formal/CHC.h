@@ -248,6 +248,14 @@ private:
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
 	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Queries @a _interface without reporting solver failures.
+	/// Only reads the settings, so it can be called concurrently for separate interfaces.
+	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> solveQuery(
+		smtutil::CHCSolverInterface& _interface,
+		smtutil::Expression const& _query
+	) const;
+	/// Reports solver failures of the query at @a _location.
+	void reportQueryFailure(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -255,6 +263,7 @@ private:
 	// Forward declarations. Definitions are below.
 	struct CHCVerificationTarget;
 	struct CHCQueryPlaceholder;
+	struct CHCTargetCheck;
 	void checkAssertTarget(ASTNode const* _scope, CHCVerificationTarget const& _target);
 	void checkAndReportTarget(
 		CHCVerificationTarget const& _target,
@@ -263,6 +272,22 @@ private:
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Encodes all of @a _checks and then solves them using up to m_settings.jobs threads,
+	/// each with its own copy of the Horn solver.
+	/// The results are reported in the order of @a _checks, so that the report
+	/// does not depend on the number of threads.
+	void checkAndReportTargets(std::vector<CHCTargetCheck> const& _checks);
+	/// Adds an error block reachable from @a _placeholders for @a _target.
+	/// @returns the query of the target.
+	smtutil::Expression encodeTarget(CHCVerificationTarget const& _target, std::vector<CHCQueryPlaceholder> const& _placeholders);
+	/// @returns true if @a _target was already shown to be violated in another context.
+	bool isUnsafe(CHCVerificationTarget const& _target) const;
+	/// Records the answer to the query @a _errorPredicate of @a _target.
+	void reportTarget(
+		CHCTargetCheck const& _check,
+		std::string const& _errorPredicate,
+		std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> const& _answer
+	);
 
 	std::optional<std::string> generateCounterexample(smtutil::CHCSolverInterface::CexGraph const& _graph, std::string const& _root);
 
@@ -362,6 +387,17 @@ private:
 		smtutil::Expression const fromPredicate;
 	};
 
+	/// A verification target combined with all contexts it can be reached from
+	/// and the messages to report once it has been checked.
+	struct CHCTargetCheck
+	{
+		CHCVerificationTarget const& target;
+		std::vector<CHCQueryPlaceholder> const& placeholders;
+		langutil::ErrorId errorReporterId;
+		std::string satMsg;
+		std::string unknownMsg;
+	};
+
 	/// Query placeholders for constructors, if the key has type ContractDefinition*,
 	/// or external functions, if the key has type FunctionDefinition*.
 	/// A placeholder is created for each possible context of a function (e.g. multiple contracts in contract inheritance hierarchy).
@@ -424,6 +460,8 @@ private:
 
 	std::map<util::h256, std::string> const& m_smtlib2Responses;
 	ReadCallback::Callback const& m_smtCallback;
+	/// Persistent cache of solver answers, null if disabled.
+	std::shared_ptr<smtutil::QueryCache> m_queryCache;
 };
 
 }
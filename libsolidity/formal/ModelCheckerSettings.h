@@ -20,6 +20,8 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <boost/filesystem.hpp>
+
 #include <optional>
 #include <set>
 
@@ -142,6 +144,9 @@ struct ModelCheckerTargets
 
 struct ModelCheckerSettings
 {
+	/// Directory of the persistent cache of solver answers.
+	/// The cache is not used if this is empty.
+	boost::filesystem::path cacheDir;
 	ModelCheckerContracts contracts = ModelCheckerContracts::Default();
 	/// Currently division and modulo are replaced by multiplication with slack vars, such that
 	/// a / b <=> a = b * k + m
@@ -152,6 +157,11 @@ struct ModelCheckerSettings
 	bool divModNoSlacks = false;
 	ModelCheckerEngine engine = ModelCheckerEngine::None();
 	ModelCheckerInvariants invariants = ModelCheckerInvariants::Default();
+	/// Number of threads the engines may use to check independent targets concurrently.
+	unsigned jobs = 1;
+	/// Query all solvers concurrently and take the first answer
+	/// instead of asking them one after another.
+	bool raceSolvers = false;
 	bool showUnproved = false;
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::Z3();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
@@ -161,10 +171,13 @@ struct ModelCheckerSettings
 	bool operator==(ModelCheckerSettings const& _other) const noexcept
 	{
 		return
+			cacheDir == _other.cacheDir &&
 			contracts == _other.contracts &&
 			divModNoSlacks == _other.divModNoSlacks &&
 			engine == _other.engine &&
 			invariants == _other.invariants &&
+			jobs == _other.jobs &&
+			raceSolvers == _other.raceSolvers &&
 			showUnproved == _other.showUnproved &&
 			solvers == _other.solvers &&
 			targets == _other.targets &&
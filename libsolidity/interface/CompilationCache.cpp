@@ -0,0 +1,219 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace fs = boost::filesystem;
+
+optional<Json::Value> CompilationCache::load(h256 const& _key, ReadCallback::Callback const& _readFile)
+{
+	fs::path const path = entryPath(_key);
+	boost::system::error_code error;
+	if (!fs::is_regular_file(path, error))
+	{
+		++m_misses;
+		return nullopt;
+	}
+
+	Json::Value entry;
+	try
+	{
+		if (!jsonParseStrict(readFileAsString(path), entry) || !entry.isObject())
+		{
+			++m_misses;
+			return nullopt;
+		}
+	}
+	catch (Exception const&)
+	{
+		// The entry might have been evicted concurrently.
+		++m_misses;
+		return nullopt;
+	}
+
+	for (auto const& importPath: entry["imports"].getMemberNames())
+	{
+		ReadCallback::Result result =
+			_readFile ?
+			_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath) :
+			ReadCallback::Result{false, ""};
+		if (
+			!result.success ||
+			keccak256(result.responseOrErrorMessage).hex() != entry["imports"][importPath].asString()
+		)
+		{
+			++m_misses;
+			return nullopt;
+		}
+	}
+
+	// Mark the entry as recently used.
+	fs::last_write_time(path, time(nullptr), error);
+	++m_hits;
+	return entry["output"];
+}
+
+void CompilationCache::store(
+	h256 const& _key,
+	Json::Value const& _output,
+	map<string, string> const& _importedSources
+)
+{
+	Json::Value entry{Json::objectValue};
+	entry["imports"] = Json::objectValue;
+	for (auto const& [path, content]: _importedSources)
+		entry["imports"][path] = keccak256(content).hex();
+	entry["output"] = _output;
+
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	// Write to a temporary file first, so that concurrent readers never see partial entries.
+	fs::path const path = entryPath(_key);
+	uint64_t replacedSize = 0;
+	if (fs::is_regular_file(path, error))
+		replacedSize = fs::file_size(path, error);
+	if (error)
+		replacedSize = 0;
+	fs::path const temporaryPath = fs::unique_path(path.string() + ".%%%%%%%%.tmp", error);
+	if (error)
+		return;
+	{
+		ofstream file(temporaryPath.string(), ios::out | ios::trunc | ios::binary);
+		file << jsonCompactPrint(entry);
+		if (!file)
+		{
+			fs::remove(temporaryPath, error);
+			return;
+		}
+	}
+	fs::rename(temporaryPath, path, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		return;
+	}
+
+	optional<uint64_t> totalSize = readTotalSize();
+	uint64_t const size = fs::file_size(path, error);
+	if (!totalSize || error)
+	{
+		evict();
+		return;
+	}
+	*totalSize += size;
+	*totalSize -= min(replacedSize, *totalSize);
+	if (*totalSize > m_sizeLimit)
+		evict();
+	else
+		writeTotalSize(*totalSize);
+}
+
+fs::path CompilationCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
+
+optional<uint64_t> CompilationCache::readTotalSize() const
+{
+	ifstream file(totalSizePath().string());
+	uint64_t totalSize = 0;
+	if (file >> totalSize)
+		return totalSize;
+	return nullopt;
+}
+
+void CompilationCache::writeTotalSize(uint64_t _totalSize) const
+{
+	boost::system::error_code error;
+	fs::path const temporaryPath = fs::unique_path(totalSizePath().string() + ".%%%%%%%%.tmp", error);
+	if (error)
+		return;
+	{
+		ofstream file(temporaryPath.string(), ios::out | ios::trunc);
+		file << _totalSize;
+		if (!file)
+		{
+			fs::remove(temporaryPath, error);
+			return;
+		}
+	}
+	fs::rename(temporaryPath, totalSizePath(), error);
+	if (error)
+		fs::remove(temporaryPath, error);
+}
+
+void CompilationCache::evict() const
+{
+	struct Entry
+	{
+		fs::path path;
+		time_t lastUsed;
+		uint64_t size;
+	};
+	vector<Entry> entries;
+	uint64_t totalSize = 0;
+
+	boost::system::error_code error;
+	for (fs::directory_iterator it(m_directory, error), end; !error && it != end; it.increment(error))
+	{
+		fs::path const& path = it->path();
+		if (path.extension() != ".json" || !fs::is_regular_file(path, error))
+			continue;
+		uint64_t size = fs::file_size(path, error);
+		if (error)
+			continue;
+		entries.push_back({path, fs::last_write_time(path, error), size});
+		totalSize += size;
+	}
+
+	uint64_t const targetSize = m_sizeLimit / 4 * 3;
+	if (totalSize <= targetSize)
+	{
+		writeTotalSize(totalSize);
+		return;
+	}
+
+	sort(entries.begin(), entries.end(), [](Entry const& _a, Entry const& _b) {
+		return _a.lastUsed < _b.lastUsed;
+	});
+	for (Entry const& entry: entries)
+	{
+		if (totalSize <= targetSize)
+			break;
+		if (fs::remove(entry.path, error))
+			totalSize -= entry.size;
+	}
+	writeTotalSize(totalSize);
+}
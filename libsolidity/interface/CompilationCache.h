@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * On-disk cache of compilation results.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/ReadFile.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Content-addressed cache of compiler outputs, stored as one file per entry in a directory.
+ *
+ * The key is provided by the user and has to cover the compiler input including the
+ * compiler version. Files that were loaded through the import callback during compilation
+ * are not known in advance, so their contents are stored with the entry and compared
+ * against the current ones before the entry is used.
+ *
+ * The total size of all entries is tracked in a file next to them, so that storing an entry does not
+ * have to scan the directory. Once it exceeds the limit, the least recently used entries are removed
+ * until a quarter of the limit is free again, which also corrects the tracked size in case concurrent
+ * processes updated it at the same time.
+ */
+class CompilationCache
+{
+public:
+	explicit CompilationCache(boost::filesystem::path _directory, uint64_t _sizeLimit = 1024 * 1024 * 1024):
+		m_directory(std::move(_directory)),
+		m_sizeLimit(_sizeLimit)
+	{}
+
+	/// @returns the output stored under @a _key, provided that all files imported during its
+	/// compilation still have the same content when read using @a _readFile.
+	std::optional<Json::Value> load(util::h256 const& _key, ReadCallback::Callback const& _readFile);
+
+	/// Stores @a _output under @a _key, together with the contents of the files that had to be
+	/// imported to produce it. Failures to write are ignored, the cache is only an optimization.
+	void store(
+		util::h256 const& _key,
+		Json::Value const& _output,
+		std::map<std::string, std::string> const& _importedSources
+	);
+
+	size_t hits() const { return m_hits; }
+	size_t misses() const { return m_misses; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+	boost::filesystem::path totalSizePath() const { return m_directory / "total-size"; }
+	/// @returns the tracked total size of all entries or nullopt if it is not known.
+	std::optional<uint64_t> readTotalSize() const;
+	void writeTotalSize(uint64_t _totalSize) const;
+	/// Removes least recently used entries until at most three quarters of the limit are used
+	/// and stores the resulting total size.
+	void evict() const;
+
+	boost::filesystem::path m_directory;
+	uint64_t m_sizeLimit;
+	size_t m_hits = 0;
+	size_t m_misses = 0;
+};
+
+}
@@ -59,6 +59,7 @@
 #include <libsolidity/codegen/ir/Common.h>
 #include <libsolidity/codegen/ir/IRGenerator.h>
 
+#include <libyul/ObjectOptimizationCache.h>
 #include <libyul/YulString.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AsmJsonConverter.h>
@@ -74,6 +75,7 @@
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/OptimiserProfile.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
 
@@ -314,6 +316,7 @@ void CompilerStack::reset(bool _keepSettings)
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_generateIR = false;
 		m_generateEwasm = false;
+		m_profileOptimiser = false;
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
@@ -324,6 +327,7 @@ void CompilerStack::reset(bool _keepSettings)
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_yulOptimizationCache.reset();
 	m_errorReporter.clear();
 	TypeProvider::reset();
 }
@@ -671,6 +675,7 @@ bool CompilerStack::compile(State _stopAfter)
 
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	m_yulOptimizationCache = make_shared<yul::ObjectOptimizationCache>();
 
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
@@ -721,6 +726,11 @@ bool CompilerStack::compile(State _stopAfter)
 							throw;
 					}
 				}
+	m_yulOptimizationCache.reset();
+	// The IR of contracts that were only generated as dependencies is not assembled,
+	// so release it together with its AST.
+	for (auto& contract: m_contracts)
+		contract.second.yulIRStack.reset();
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
@@ -890,6 +900,17 @@ string const& CompilerStack::yulIROptimized(string const& _contractName) const
 	return contract(_contractName).yulIROptimized;
 }
 
+Json::Value CompilerStack::optimiserProfile(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	Contract const& compiledContract = contract(_contractName);
+	if (!compiledContract.optimiserProfile)
+		return Json::nullValue;
+	return compiledContract.optimiserProfile->toJson();
+}
+
 string const& CompilerStack::ewasm(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
@@ -1309,6 +1330,30 @@ void CompilerStack::assemble(
 			"Consider enabling the optimizer (with a low \"runs\" value!), "
 			"turning off revert strings, or using libraries."
 		);
+
+	// The runtime assembly is a sub-assembly of the deployment assembly.
+	if (compiledContract.evmAssembly->optimiserIterationLimitReached())
+		m_errorReporter.warning(
+			4628_error,
+			_contract.location(),
+			"The EVM assembly optimizer stopped at its iteration limit (\"maxIterations\": "s +
+			to_string(m_optimiserSettings.maxIterations) +
+			") while it was still changing the code. "
+			"The generated code is correct but might be less optimized. "
+			"Consider increasing the limit."
+		);
+}
+
+OptimiserSettings CompilerStack::optimiserSettings(Contract& _contract)
+{
+	OptimiserSettings settings = m_optimiserSettings;
+	if (m_profileOptimiser)
+	{
+		if (!_contract.optimiserProfile)
+			_contract.optimiserProfile = make_shared<util::OptimiserProfile>();
+		settings.profile = _contract.optimiserProfile;
+	}
+	return settings;
 }
 
 void CompilerStack::compileContract(
@@ -1333,7 +1378,7 @@ void CompilerStack::compileContract(
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, optimiserSettings(compiledContract));
 	compiledContract.compiler = compiler;
 
 	solAssert(!m_viaIR, "");
@@ -1387,16 +1432,27 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		m_evmVersion,
 		m_eofVersion,
 		m_revertStrings,
-		m_optimiserSettings,
+		optimiserSettings(compiledContract),
 		sourceIndices(),
 		m_debugInfoSelection,
-		this
+		this,
+		m_yulOptimizationCache
 	);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(
+	tie(compiledContract.yulIR, compiledContract.yulIRStack) = generator.run(
 		_contract,
 		createCBORMetadata(compiledContract, /* _forIR */ true),
 		otherYulSources
 	);
+	solAssert(compiledContract.yulIRStack, "");
+
+	// Without source locations in the debug info, the bytecode is generated from the printed IR,
+	// which lacks the location comments, so that the source mappings do not refer to the sources.
+	bool const bytecodeFromText = m_viaIR && m_generateEvmBytecode && !m_debugInfoSelection.location;
+	// Printing large objects is expensive, so only do it if the text is actually needed.
+	if (m_generateIR || m_generateEwasm || bytecodeFromText)
+		compiledContract.yulIROptimized = compiledContract.yulIRStack->print(this);
+	if (!m_viaIR || !m_generateEvmBytecode || bytecodeFromText)
+		compiledContract.yulIRStack.reset();
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1409,26 +1465,32 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::YulStack stack(
-		m_evmVersion,
-		m_eofVersion,
-		yul::YulStack::Language::StrictAssembly,
-		m_optimiserSettings,
-		m_debugInfoSelection
-	);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	stack.optimize();
-
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+	// Continue with the already analyzed IR instead of printing and re-parsing it.
+	// The stack is not needed anymore afterwards, so release it together with its AST.
+	shared_ptr<yul::YulStack> stack = std::move(compiledContract.yulIRStack);
+	if (!stack)
+	{
+		// The in-memory IR keeps the source locations, which the selected debug info excludes.
+		solAssert(!m_debugInfoSelection.location && !compiledContract.yulIROptimized.empty(), "");
+		stack = make_shared<yul::YulStack>(
+			m_evmVersion,
+			m_eofVersion,
+			yul::YulStack::Language::StrictAssembly,
+			optimiserSettings(compiledContract),
+			m_debugInfoSelection
+		);
+		stack->parseAndAnalyze("", compiledContract.yulIROptimized);
+	}
+	// Another optimizer run can still improve the code, so it is kept for the sake of
+	// identical output. It is a no-op if the optimizer is disabled.
+	stack->optimize();
 
 	string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
+	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack->assembleEVMWithDeployed(deployedName);
 	assemble(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
 }
 
@@ -1451,7 +1513,7 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 		m_evmVersion,
 		m_eofVersion,
 		yul::YulStack::Language::StrictAssembly,
-		m_optimiserSettings,
+		optimiserSettings(compiledContract),
 		m_debugInfoSelection
 	);
 	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
@@ -1554,11 +1616,14 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 	static_assert(sizeof(m_optimiserSettings.expectedExecutionsPerDeployment) <= sizeof(Json::LargestUInt), "Invalid word size.");
 	solAssert(static_cast<Json::LargestUInt>(m_optimiserSettings.expectedExecutionsPerDeployment) < std::numeric_limits<Json::LargestUInt>::max(), "");
 	meta["settings"]["optimizer"]["runs"] = Json::Value(Json::LargestUInt(m_optimiserSettings.expectedExecutionsPerDeployment));
+	if (m_optimiserSettings.maxIterations != OptimiserSettings{}.maxIterations)
+		meta["settings"]["optimizer"]["maxIterations"] = Json::Value(Json::LargestUInt(m_optimiserSettings.maxIterations));
 
 	/// Backwards compatibility: If set to one of the default settings, do not provide details.
 	OptimiserSettings settingsWithoutRuns = m_optimiserSettings;
 	// reset to default
 	settingsWithoutRuns.expectedExecutionsPerDeployment = OptimiserSettings::minimal().expectedExecutionsPerDeployment;
+	settingsWithoutRuns.maxIterations = OptimiserSettings::minimal().maxIterations;
 	if (settingsWithoutRuns == OptimiserSettings::minimal())
 		meta["settings"]["optimizer"]["enabled"] = false;
 	else if (settingsWithoutRuns == OptimiserSettings::standard())
@@ -62,6 +62,12 @@ class CharStream;
 }
 
 
+namespace solidity::yul
+{
+class ObjectOptimizationCache;
+class YulStack;
+}
+
 namespace solidity::evmasm
 {
 class Assembly;
@@ -206,6 +212,9 @@ public:
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
 
+	/// Enable collection of statistics about the optimiser steps run for each contract.
+	void enableOptimiserProfiling(bool _enable = true) { m_profileOptimiser = _enable; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -282,6 +291,10 @@ public:
 	/// @returns the optimized IR representation of a contract.
 	std::string const& yulIROptimized(std::string const& _contractName) const;
 
+	/// @returns statistics about the optimiser steps run during the compilation of a contract
+	/// or null if optimiser profiling was not enabled.
+	Json::Value optimiserProfile(std::string const& _contractName) const;
+
 	/// @returns the Ewasm text representation of a contract.
 	std::string const& ewasm(std::string const& _contractName) const;
 
@@ -388,7 +401,11 @@ private:
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Yul IR code.
-		std::string yulIROptimized; ///< Optimized Yul IR code.
+		std::string yulIROptimized; ///< Optimized Yul IR code. Only printed if IR output was requested.
+		/// Parsed, analyzed and optimized Yul IR, kept until EVM code is generated from it.
+		std::shared_ptr<yul::YulStack> yulIRStack;
+		/// Statistics about the optimiser steps. Only set if optimiser profiling was enabled.
+		std::shared_ptr<util::OptimiserProfile> optimiserProfile;
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -429,6 +446,10 @@ private:
 		std::shared_ptr<evmasm::Assembly> _runtimeAssembly
 	);
 
+	/// @returns the optimiser settings to be used for @a _contract, which differ from the
+	/// configured ones only in the profile the optimiser steps are recorded in.
+	OptimiserSettings optimiserSettings(Contract& _contract);
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
@@ -508,6 +529,7 @@ private:
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
 	bool m_generateEwasm = false;
+	bool m_profileOptimiser = false;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
@@ -518,6 +540,9 @@ private:
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
+	/// Optimized Yul objects, so that the code of a contract is optimized only once even if
+	/// other contracts embed it. Only used during compilation.
+	std::shared_ptr<yul::ObjectOptimizationCache> m_yulOptimizationCache;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
@@ -26,8 +26,14 @@
 #include <liblangutil/Exceptions.h>
 
 #include <cstddef>
+#include <memory>
 #include <string>
 
+namespace solidity::util
+{
+class OptimiserProfile;
+}
+
 namespace solidity::frontend
 {
 
@@ -120,7 +126,8 @@ struct OptimiserSettings
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			maxIterations == _other.maxIterations;
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
@@ -155,6 +162,15 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Maximum number of times the EVM assembly optimizer repeats its passes on each assembly.
+	size_t maxIterations = 1000;
+	/// If set, statistics about the optimiser steps are collected here.
+	/// Does not influence the generated code and is thus not part of the comparison.
+	std::shared_ptr<util::OptimiserProfile> profile;
+	/// Number of threads used to optimise independent parts of the code, currently the
+	/// sub-assemblies in the EVM assembly optimizer.
+	/// Does not influence the generated code and is thus not part of the comparison.
+	size_t jobs = 1;
 };
 
 }
@@ -38,6 +38,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/OptimiserProfile.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -445,13 +446,13 @@ std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"contracts", "divModNoSlacks", "engine", "invariants", "showUnproved", "solvers", "targets", "timeout"};
+	static set<string> keys{"contracts", "divModNoSlacks", "engine", "invariants", "jobs", "raceSolvers", "showUnproved", "solvers", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
 std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 {
-	static set<string> keys{"details", "enabled", "runs"};
+	static set<string> keys{"details", "enabled", "jobs", "maxIterations", "runs"};
 	return checkKeys(_input, keys, "settings.optimizer");
 }
 
@@ -593,6 +594,20 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 		settings.expectedExecutionsPerDeployment = _jsonInput["runs"].asUInt();
 	}
 
+	if (_jsonInput.isMember("maxIterations"))
+	{
+		if (!_jsonInput["maxIterations"].isUInt() || _jsonInput["maxIterations"].asUInt() == 0)
+			return formatFatalError(Error::Type::JSONError, "The \"maxIterations\" setting must be a positive integer.");
+		settings.maxIterations = _jsonInput["maxIterations"].asUInt();
+	}
+
+	if (_jsonInput.isMember("jobs"))
+	{
+		if (!_jsonInput["jobs"].isUInt() || _jsonInput["jobs"].asUInt() == 0)
+			return formatFatalError(Error::Type::JSONError, "The \"jobs\" setting must be a positive integer.");
+		settings.jobs = _jsonInput["jobs"].asUInt();
+	}
+
 	if (_jsonInput.isMember("details"))
 	{
 		Json::Value const& details = _jsonInput["details"];
@@ -813,7 +828,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 
 	if (settings.isMember("debug"))
 	{
-		if (auto result = checkKeys(settings["debug"], {"revertStrings", "debugInfo"}, "settings.debug"))
+		if (auto result = checkKeys(settings["debug"], {"revertStrings", "debugInfo", "profile"}, "settings.debug"))
 			return *result;
 
 		if (settings["debug"].isMember("revertStrings"))
@@ -855,6 +870,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 
 			ret.debugInfoSelection = debugInfoSelection.value();
 		}
+
+		if (settings["debug"].isMember("profile"))
+		{
+			if (!settings["debug"]["profile"].isBool())
+				return formatFatalError(Error::Type::JSONError, "settings.debug.profile must be a Boolean.");
+			ret.profileOptimiser = settings["debug"]["profile"].asBool();
+		}
 	}
 
 	if (settings.isMember("remappings") && !settings["remappings"].isArray())
@@ -1037,6 +1059,22 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.invariants = invariants;
 	}
 
+	if (modelCheckerSettings.isMember("jobs"))
+	{
+		auto const& jobs = modelCheckerSettings["jobs"];
+		if (!jobs.isUInt() || jobs.asUInt() == 0)
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.jobs must be a positive integer.");
+		ret.modelCheckerSettings.jobs = jobs.asUInt();
+	}
+
+	if (modelCheckerSettings.isMember("raceSolvers"))
+	{
+		auto const& raceSolvers = modelCheckerSettings["raceSolvers"];
+		if (!raceSolvers.isBool())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.raceSolvers must be a Boolean value.");
+		ret.modelCheckerSettings.raceSolvers = raceSolvers.asBool();
+	}
+
 	if (modelCheckerSettings.isMember("showUnproved"))
 	{
 		auto const& showUnproved = modelCheckerSettings["showUnproved"];
@@ -1120,6 +1158,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+	compilerStack.enableOptimiserProfiling(_inputsAndSettings.profileOptimiser);
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
@@ -1368,6 +1407,13 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		if (!evmData.empty())
 			contractData["evm"] = evmData;
 
+		if (compilationSuccess && _inputsAndSettings.profileOptimiser)
+		{
+			Json::Value profile = compilerStack.optimiserProfile(contractName);
+			if (!profile.isNull())
+				contractData["optimizerProfile"] = std::move(profile);
+		}
+
 		if (!contractData.empty())
 		{
 			if (!contractsOutput.isMember(file))
@@ -1382,6 +1428,43 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 }
 
 
+Json::Value StandardCompiler::compileSolidityCached(Json::Value const& _input, InputsAndSettings _inputsAndSettings)
+{
+	solAssert(m_cache);
+
+	// Sources specified by URL were already loaded while parsing the input, so the key
+	// has to include the loaded contents, not only the input itself.
+	string key = string(VersionString) + "\n" + util::jsonCompactPrint(_input);
+	for (auto const& [sourceName, content]: _inputsAndSettings.sources)
+		key += "\n" + util::keccak256(sourceName).hex() + util::keccak256(content).hex();
+	util::h256 const cacheKey = util::keccak256(key);
+
+	if (optional<Json::Value> output = m_cache->load(cacheKey, m_readFile))
+		return std::move(*output);
+
+	// Record the files that are imported during compilation, so that the entry can be
+	// invalidated once one of them changes.
+	map<string, string> importedSources;
+	ReadCallback::Callback readFile = m_readFile;
+	ScopeGuard restoreReadFile{[&]() { m_readFile = readFile; }};
+	if (readFile)
+		m_readFile = [&](string const& _kind, string const& _path) {
+			ReadCallback::Result result = readFile(_kind, _path);
+			if (result.success && _kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile))
+				importedSources[_path] = result.responseOrErrorMessage;
+			return result;
+		};
+
+	Json::Value output = compileSolidity(std::move(_inputsAndSettings));
+
+	for (Json::Value const& error: output["errors"])
+		if (error["severity"] == "error")
+			return output;
+
+	m_cache->store(cacheKey, output, importedSources);
+	return output;
+}
+
 Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 {
 	Json::Value output = Json::objectValue;
@@ -1424,6 +1507,10 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		return output;
 	}
 
+	if (_inputsAndSettings.profileOptimiser)
+		_inputsAndSettings.optimiserSettings.profile = make_shared<util::OptimiserProfile>();
+	shared_ptr<util::OptimiserProfile> profile = _inputsAndSettings.optimiserSettings.profile;
+
 	YulStack stack(
 		_inputsAndSettings.evmVersion,
 		_inputsAndSettings.eofVersion,
@@ -1513,6 +1600,8 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		output["contracts"][sourceName][contractName]["irOptimized"] = stack.print();
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "evm.assembly", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["evm"]["assembly"] = object.assembly;
+	if (profile)
+		output["contracts"][sourceName][contractName]["optimizerProfile"] = profile->toJson();
 
 	return output;
 }
@@ -1520,7 +1609,9 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	// Frees the Yul identifiers of earlier calls. The compiler does not support
+	// running several compilations concurrently.
+	YulStringRepository::Scope yulStringScope;
 
 	try
 	{
@@ -1529,7 +1620,13 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
+		{
+			// The results of the model checker depend on the available solvers and on timeouts.
+			// Profiles are only meaningful for an actual compilation.
+			if (m_cache && settings.modelCheckerSettings.engine.none() && !settings.profileOptimiser)
+				return compileSolidityCached(_input, std::move(settings));
 			return compileSolidity(std::move(settings));
+		}
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolutil/JSON.h>
 
@@ -49,10 +50,13 @@ public:
 	/// Creates a new StandardCompiler.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
+	/// @param _cache optional on-disk cache, consulted before compiling Solidity sources.
 	explicit StandardCompiler(ReadCallback::Callback _readFile = ReadCallback::Callback(),
-		util::JsonFormat const& _format = {}):
+		util::JsonFormat const& _format = {},
+		std::shared_ptr<CompilationCache> _cache = nullptr):
 		m_readFile(std::move(_readFile)),
-		m_jsonPrintingFormat(std::move(_format))
+		m_jsonPrintingFormat(std::move(_format)),
+		m_cache(std::move(_cache))
 	{
 	}
 
@@ -82,6 +86,7 @@ private:
 		RevertStrings revertStrings = RevertStrings::Default;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
+		bool profileOptimiser = false;
 		std::map<std::string, util::h160> libraries;
 		bool metadataLiteralSources = false;
 		CompilerStack::MetadataFormat metadataFormat = CompilerStack::defaultMetadataFormat();
@@ -96,11 +101,16 @@ private:
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
 	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Like @a compileSolidity, but looks up the output in the cache first and stores it there
+	/// afterwards. @a _input is the unprocessed input that @a _inputsAndSettings was parsed from.
+	Json::Value compileSolidityCached(Json::Value const& _input, InputsAndSettings _inputsAndSettings);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
 
 	util::JsonFormat m_jsonPrintingFormat;
+
+	std::shared_ptr<CompilationCache> m_cache;
 };
 
 }
@@ -0,0 +1,200 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/ASTIndex.h>
+#include <libsolidity/lsp/Utils.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <libyul/AST.h>
+
+#include <algorithm>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+using namespace std;
+
+class ASTIndex::Builder: public ASTConstVisitor
+{
+public:
+	explicit Builder(ASTIndex& _index): m_index(_index) {}
+
+	void build(SourceUnit const& _sourceUnit)
+	{
+		solAssert(_sourceUnit.location().sourceName);
+		m_index.m_sourceUnits[*_sourceUnit.location().sourceName] = m_index.m_nodes.size();
+		_sourceUnit.accept(*this);
+		solAssert(m_path.empty());
+	}
+
+	bool visitNode(ASTNode const& _node) override
+	{
+		size_t const index = m_index.m_nodes.size();
+		m_index.m_nodes.push_back({&_node, {}});
+		if (!m_path.empty())
+			m_index.m_nodes[m_path.back()].children.push_back(index);
+		m_path.push_back(index);
+		return true;
+	}
+
+	void endVisitNode(ASTNode const&) override
+	{
+		vector<size_t>& children = m_index.m_nodes[m_path.back()].children;
+		stable_sort(children.begin(), children.end(), [&](size_t _a, size_t _b) {
+			return m_index.m_nodes[_a].node->location().start < m_index.m_nodes[_b].node->location().start;
+		});
+		m_path.pop_back();
+	}
+
+	bool visit(ContractDefinition const& _node) override { return declaration(_node); }
+	bool visit(StructDefinition const& _node) override { return declaration(_node); }
+	bool visit(EnumDefinition const& _node) override { return declaration(_node); }
+	bool visit(EnumValue const& _node) override { return declaration(_node); }
+	bool visit(UserDefinedValueTypeDefinition const& _node) override { return declaration(_node); }
+	bool visit(VariableDeclaration const& _node) override { return declaration(_node); }
+	bool visit(FunctionDefinition const& _node) override { return declaration(_node); }
+	bool visit(ModifierDefinition const& _node) override { return declaration(_node); }
+	bool visit(EventDefinition const& _node) override { return declaration(_node); }
+	bool visit(ErrorDefinition const& _node) override { return declaration(_node); }
+
+	bool visit(ImportDirective const& _node) override
+	{
+		// Handles SourceUnit aliases
+		if (!_node.name().empty())
+			reference(_node, _node.name(), _node.nameLocation());
+
+		for (ImportDirective::SymbolAlias const& symbolAlias: _node.symbolAliases())
+			if (symbolAlias.alias)
+				if (auto const* declaration = symbolAlias.symbol->annotation().referencedDeclaration)
+					reference(*declaration, *symbolAlias.alias, symbolAlias.location);
+		return visitNode(_node);
+	}
+
+	bool visit(MemberAccess const& _node) override
+	{
+		if (auto const* declaration = _node.annotation().referencedDeclaration)
+			reference(*declaration, _node.memberName(), _node.memberLocation());
+		return visitNode(_node);
+	}
+
+	bool visit(Identifier const& _node) override
+	{
+		if (auto const* declaration = _node.annotation().referencedDeclaration)
+			reference(*declaration, _node.name(), _node.location());
+		return visitNode(_node);
+	}
+
+	bool visit(IdentifierPath const& _node) override
+	{
+		vector<Declaration const*> const& declarations = _node.annotation().pathDeclarations;
+		solAssert(declarations.size() == _node.path().size());
+
+		for (size_t i = 0; i < _node.path().size(); i++)
+			if (declarations[i])
+				reference(*declarations[i], _node.path()[i], _node.pathLocations()[i]);
+		return visitNode(_node);
+	}
+
+	bool visit(FunctionCall const& _node) override
+	{
+		// Names of named arguments refer to the parameters of the called function.
+		if (auto const* functionDefinition = calledFunctionDefinition(_node))
+			for (size_t i = 0; i < _node.names().size(); i++)
+				for (auto const& parameter: functionDefinition->parameters())
+					if (parameter && _node.names()[i] && parameter->name() == *_node.names()[i])
+						reference(*parameter, parameter->name(), _node.nameLocations()[i]);
+		return visitNode(_node);
+	}
+
+	bool visit(InlineAssembly const& _node) override
+	{
+		for (auto&& [identifier, externalReference]: _node.annotation().externalReferences)
+		{
+			if (!externalReference.declaration)
+				continue;
+
+			string name = identifier->name.str();
+			if (!externalReference.suffix.empty())
+				name = name.substr(0, name.length() - externalReference.suffix.size() - 1);
+			SourceLocation location = yul::nativeLocationOf(*identifier);
+			location.end -= static_cast<int>(externalReference.suffix.size() + 1);
+			reference(*externalReference.declaration, std::move(name), std::move(location));
+		}
+		return visitNode(_node);
+	}
+
+private:
+	bool declaration(Declaration const& _declaration)
+	{
+		reference(_declaration, _declaration.name(), _declaration.nameLocation());
+		return visitNode(_declaration);
+	}
+
+	void reference(Declaration const& _declaration, string _name, SourceLocation _location)
+	{
+		m_index.m_references[_declaration.id()].push_back({std::move(_location), std::move(_name)});
+	}
+
+	ASTIndex& m_index;
+	/// Indices of the nodes that are currently being visited, from the root.
+	vector<size_t> m_path;
+};
+
+ASTIndex::ASTIndex(vector<SourceUnit const*> const& _sourceUnits)
+{
+	Builder builder(*this);
+	for (SourceUnit const* sourceUnit: _sourceUnits)
+		builder.build(*sourceUnit);
+}
+
+ASTNode const* ASTIndex::innermostNode(string const& _sourceUnitName, int _offset) const
+{
+	auto const sourceUnit = m_sourceUnits.find(_sourceUnitName);
+	if (sourceUnit == m_sourceUnits.end())
+		return nullptr;
+
+	// In the AST parent location always covers the whole child location and
+	// sibling locations do not overlap, so at most one child can contain the offset.
+	Node const* innermost = &m_nodes[sourceUnit->second];
+	if (!innermost->node->location().containsOffset(_offset))
+		return nullptr;
+	while (true)
+	{
+		auto const child = upper_bound(
+			innermost->children.begin(),
+			innermost->children.end(),
+			_offset,
+			[&](int _value, size_t _child) { return _value < m_nodes[_child].node->location().start; }
+		);
+		if (child == innermost->children.begin())
+			break;
+		Node const& candidate = m_nodes[*prev(child)];
+		if (!candidate.node->location().containsOffset(_offset))
+			break;
+		innermost = &candidate;
+	}
+	return innermost->node;
+}
+
+vector<ASTIndex::Reference> const& ASTIndex::references(Declaration const& _declaration) const
+{
+	static vector<Reference> const noReferences;
+	auto const references = m_references.find(_declaration.id());
+	return references == m_references.end() ? noReferences : references->second;
+}
@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace solidity::lsp
+{
+
+/**
+ * Index over the ASTs of one analysis, so that requests do not have to traverse the ASTs.
+ *
+ * It maps source offsets to the innermost AST node containing them and declarations
+ * to all places in the sources that refer to them, including their own names.
+ */
+class ASTIndex
+{
+public:
+	/// A place in the sources that refers to a declaration.
+	struct Reference
+	{
+		langutil::SourceLocation location;
+		/// The name used at @a location, which differs from the name of the declaration
+		/// for symbols imported under an alias.
+		std::string name;
+	};
+
+	explicit ASTIndex(std::vector<frontend::SourceUnit const*> const& _sourceUnits);
+
+	/// @returns the innermost AST node of the source unit @a _sourceUnitName
+	/// that contains @a _offset, or nullptr if there is none.
+	frontend::ASTNode const* innermostNode(std::string const& _sourceUnitName, int _offset) const;
+
+	/// @returns all references to @a _declaration in the order they appear in the ASTs.
+	std::vector<Reference> const& references(frontend::Declaration const& _declaration) const;
+
+private:
+	class Builder;
+
+	struct Node
+	{
+		frontend::ASTNode const* node;
+		/// Indices of the child nodes, sorted by the start of their location.
+		std::vector<size_t> children;
+	};
+
+	/// All nodes in the order they are visited.
+	std::vector<Node> m_nodes;
+	/// Index of the SourceUnit node per source unit name.
+	std::map<std::string, size_t> m_sourceUnits;
+	std::map<int64_t, std::vector<Reference>> m_references;
+};
+
+}
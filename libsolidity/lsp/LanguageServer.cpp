@@ -27,6 +27,7 @@
 // LSP feature implementations
 #include <libsolidity/lsp/DocumentHoverHandler.h>
 #include <libsolidity/lsp/GotoDefinition.h>
+#include <libsolidity/lsp/References.h>
 #include <libsolidity/lsp/RenameSymbol.h>
 #include <libsolidity/lsp/SemanticTokensBuilder.h>
 
@@ -41,6 +42,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <ctime>
 #include <ostream>
 #include <string>
 
@@ -59,6 +61,9 @@ namespace fs = boost::filesystem;
 namespace
 {
 
+/// Time the client has to stop sending messages after a change before the sources are analyzed again.
+chrono::milliseconds constexpr diagnosticsDelay{100};
+
 bool resolvesToRegularFile(boost::filesystem::path _path, int maxRecursionDepth = 10)
 {
 	fs::file_status fileStatus = fs::status(_path);
@@ -146,9 +151,12 @@ LanguageServer::LanguageServer(Transport& _transport):
 		{"textDocument/didChange", bind(&LanguageServer::handleTextDocumentDidChange, this, _2)},
 		{"textDocument/didClose", bind(&LanguageServer::handleTextDocumentDidClose, this, _2)},
 		{"textDocument/hover", DocumentHoverHandler(*this) },
+		{"textDocument/references", References(*this) },
 		{"textDocument/rename", RenameSymbol(*this) },
 		{"textDocument/implementation", GotoDefinition(*this) },
 		{"textDocument/semanticTokens/full", bind(&LanguageServer::semanticTokensFull, this, _1, _2)},
+		{"textDocument/semanticTokens/full/delta", bind(&LanguageServer::semanticTokensFullDelta, this, _1, _2)},
+		{"textDocument/semanticTokens/range", bind(&LanguageServer::semanticTokensRange, this, _1, _2)},
 		{"workspace/didChangeConfiguration", bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
 	},
 	m_fileRepository("/" /* basePath */, {} /* no search paths */),
@@ -189,6 +197,8 @@ void LanguageServer::changeConfiguration(Json::Value const& _settings)
 	}
 
 	m_settingsObject = _settings;
+	// The file load strategy and the include paths determine which sources are analyzed.
+	m_analyzedSources.reset();
 	Json::Value jsonIncludePaths = _settings["include-paths"];
 
 	if (jsonIncludePaths)
@@ -262,15 +272,113 @@ void LanguageServer::compile()
 			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
 		);
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+	if (analyzedSourcesUpToDate())
+	{
+		// Keep the sources loaded through imports.
+		swap(oldRepository, m_fileRepository);
+		return;
+	}
+
+	optional<StringMap> previousSources;
+	if (m_compilerStack.state() >= CompilerStack::AnalysisPerformed)
+		previousSources = std::move(m_analyzedSources);
 
+	m_astIndex.reset();
 	m_compilerStack.reset(false);
 	m_compilerStack.setSources(m_fileRepository.sourceUnits());
+	set<string> const directSources = util::keys(m_fileRepository.sourceUnits());
+	m_analysisTime = time(nullptr);
 	m_compilerStack.compile(CompilerStack::State::AnalysisPerformed);
+	// Now also contains the sources loaded through imports.
+	m_analyzedSources = m_fileRepository.sourceUnits();
+
+	m_importedFiles.clear();
+	for (auto const& [sourceUnitName, content]: *m_analyzedSources)
+		if (!directSources.count(sourceUnitName))
+		{
+			auto const path = m_fileRepository.tryResolvePath(stripFileUriSchemePrefix(sourceUnitName));
+			boost::system::error_code error;
+			if (path.message().empty())
+				m_importedFiles[sourceUnitName] = {path.get(), fs::last_write_time(path.get(), error)};
+		}
+
+	invalidateSemanticTokens(previousSources ? &*previousSources : nullptr);
+}
+
+void LanguageServer::invalidateSemanticTokens(StringMap const* _previousSources)
+{
+	bool const analysisSucceeded = m_compilerStack.state() >= CompilerStack::AnalysisPerformed;
+	auto const changed = [&](string const& _sourceUnitName) {
+		return
+			!_previousSources ||
+			!_previousSources->count(_sourceUnitName) ||
+			_previousSources->at(_sourceUnitName) != m_analyzedSources->at(_sourceUnitName);
+	};
+
+	for (auto it = m_semanticTokens.begin(); it != m_semanticTokens.end();)
+	{
+		auto& [sourceUnitName, tokens] = *it;
+		if (!m_analyzedSources->count(sourceUnitName))
+		{
+			it = m_semanticTokens.erase(it);
+			continue;
+		}
+
+		// The tokens depend on the annotations of the source unit and thus also on the
+		// sources it imports, directly or indirectly.
+		if (tokens.upToDate)
+		{
+			if (!analysisSucceeded || changed(sourceUnitName))
+				tokens.upToDate = false;
+			else
+				for (SourceUnit const* referencedSourceUnit: m_compilerStack.ast(sourceUnitName).referencedSourceUnits(true))
+					if (changed(*referencedSourceUnit->location().sourceName))
+					{
+						tokens.upToDate = false;
+						break;
+					}
+		}
+		++it;
+	}
+}
+
+bool LanguageServer::analyzedSourcesUpToDate() const
+{
+	if (!m_analyzedSources)
+		return false;
+
+	for (auto const& [sourceUnitName, content]: m_fileRepository.sourceUnits())
+		if (!m_analyzedSources->count(sourceUnitName) || m_analyzedSources->at(sourceUnitName) != content)
+			return false;
+
+	// Sources that are neither open nor part of the project were loaded via imports
+	// and might have changed on disk. Only their modification times are compared,
+	// unless they were modified in the same second as the analysis started.
+	for (auto const& [sourceUnitName, content]: *m_analyzedSources)
+		if (!m_fileRepository.sourceUnits().count(sourceUnitName))
+		{
+			auto const importedFile = m_importedFiles.find(sourceUnitName);
+			if (importedFile == m_importedFiles.end())
+				return false;
+			auto const& [path, lastWriteTime] = importedFile->second;
+
+			auto const resolvedPath = m_fileRepository.tryResolvePath(stripFileUriSchemePrefix(sourceUnitName));
+			if (!resolvedPath.message().empty() || resolvedPath.get() != path)
+				return false;
+
+			boost::system::error_code error;
+			if (fs::last_write_time(path, error) != lastWriteTime || error)
+				return false;
+			if (lastWriteTime >= m_analysisTime && util::readFileAsString(path) != content)
+				return false;
+		}
+
+	return true;
 }
 
 void LanguageServer::compileAndUpdateDiagnostics()
 {
+	m_diagnosticsOutdated = false;
 	compile();
 
 	// These are the source units we will sent diagnostics to the client for sure,
@@ -336,6 +444,10 @@ bool LanguageServer::run()
 		MessageID id;
 		try
 		{
+			// Bursts of changes are only analyzed once the client pauses.
+			if (m_diagnosticsOutdated && !m_client.waitForInput(diagnosticsDelay))
+				compileAndUpdateDiagnostics();
+
 			optional<Json::Value> const jsonMessage = m_client.receive();
 			if (!jsonMessage)
 				continue;
@@ -346,6 +458,10 @@ bool LanguageServer::run()
 				id = (*jsonMessage)["id"];
 				lspDebug(fmt::format("received method call: {}", methodName));
 
+				// Requests (as opposed to notifications) have to be answered based on the current sources.
+				if (m_diagnosticsOutdated && id != Json::nullValue)
+					compileAndUpdateDiagnostics();
+
 				if (auto handler = util::valueOrDefault(m_handlers, methodName))
 					handler(id, (*jsonMessage)["params"]);
 				else
@@ -420,8 +536,9 @@ void LanguageServer::handleInitialize(MessageID _id, Json::Value const& _args)
 	replyArgs["capabilities"]["textDocumentSync"]["change"] = 2; // 0=none, 1=full, 2=incremental
 	replyArgs["capabilities"]["textDocumentSync"]["openClose"] = true;
 	replyArgs["capabilities"]["semanticTokensProvider"]["legend"] = semanticTokensLegend();
-	replyArgs["capabilities"]["semanticTokensProvider"]["range"] = false;
-	replyArgs["capabilities"]["semanticTokensProvider"]["full"] = true; // XOR requests.full.delta = true
+	replyArgs["capabilities"]["semanticTokensProvider"]["range"] = true;
+	replyArgs["capabilities"]["semanticTokensProvider"]["full"]["delta"] = true;
+	replyArgs["capabilities"]["referencesProvider"] = true;
 	replyArgs["capabilities"]["renameProvider"] = true;
 	replyArgs["capabilities"]["hoverProvider"] = true;
 
@@ -441,16 +558,82 @@ void LanguageServer::semanticTokensFull(MessageID _id, Json::Value const& _args)
 	compile();
 
 	auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.as<string>());
-	SourceUnit const& ast = m_compilerStack.ast(sourceName);
-	m_compilerStack.charStream(sourceName);
-	Json::Value data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
+	SemanticTokens const& tokens = semanticTokens(sourceName);
+
+	Json::Value reply = Json::objectValue;
+	reply["resultId"] = to_string(tokens.version);
+	reply["data"] = tokens.data;
+
+	m_client.reply(_id, std::move(reply));
+}
+
+void LanguageServer::semanticTokensFullDelta(MessageID _id, Json::Value const& _args)
+{
+	auto uri = _args["textDocument"]["uri"];
+
+	compile();
+
+	auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.as<string>());
+
+	// The client can only apply edits to the last tokens we sent it.
+	bool knownPrevious = false;
+	bool unchanged = false;
+	Json::Value previousData;
+	if (auto const cached = m_semanticTokens.find(sourceName); cached != m_semanticTokens.end())
+		if (to_string(cached->second.version) == _args["previousResultId"].asString())
+		{
+			knownPrevious = true;
+			unchanged = cached->second.upToDate;
+			if (!unchanged)
+				previousData = std::move(cached->second.data);
+		}
+
+	SemanticTokens const& tokens = semanticTokens(sourceName);
+
+	Json::Value reply = Json::objectValue;
+	reply["resultId"] = to_string(tokens.version);
+	if (unchanged)
+		reply["edits"] = Json::arrayValue;
+	else if (knownPrevious)
+		reply["edits"] = semanticTokensEdits(previousData, tokens.data);
+	else
+		reply["data"] = tokens.data;
+
+	m_client.reply(_id, std::move(reply));
+}
+
+void LanguageServer::semanticTokensRange(MessageID _id, Json::Value const& _args)
+{
+	auto uri = _args["textDocument"]["uri"];
+	optional<LineColumn> const start = parseLineColumn(_args["range"]["start"]);
+	optional<LineColumn> const end = parseLineColumn(_args["range"]["end"]);
+	lspRequire(start && end, ErrorCode::InvalidParams, "Invalid range.");
+
+	compile();
+
+	auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.as<string>());
 
 	Json::Value reply = Json::objectValue;
-	reply["data"] = data;
+	reply["data"] = semanticTokensInRange(semanticTokens(sourceName).data, *start, *end);
 
 	m_client.reply(_id, std::move(reply));
 }
 
+LanguageServer::SemanticTokens const& LanguageServer::semanticTokens(string const& _sourceUnitName)
+{
+	SemanticTokens& tokens = m_semanticTokens[_sourceUnitName];
+	if (!tokens.upToDate)
+	{
+		tokens.data = SemanticTokensBuilder().build(
+			m_compilerStack.ast(_sourceUnitName),
+			m_compilerStack.charStream(_sourceUnitName)
+		);
+		tokens.version++;
+		tokens.upToDate = true;
+	}
+	return tokens;
+}
+
 void LanguageServer::handleWorkspaceDidChangeConfiguration(Json::Value const& _args)
 {
 	requireServerInitialized();
@@ -488,7 +671,7 @@ void LanguageServer::handleTextDocumentDidOpen(Json::Value const& _args)
 	string uri = _args["textDocument"]["uri"].asString();
 	m_openFiles.insert(uri);
 	m_fileRepository.setSourceByUri(uri, std::move(text));
-	compileAndUpdateDiagnostics();
+	m_diagnosticsOutdated = true;
 }
 
 void LanguageServer::handleTextDocumentDidChange(Json::Value const& _args)
@@ -529,7 +712,7 @@ void LanguageServer::handleTextDocumentDidChange(Json::Value const& _args)
 		m_fileRepository.setSourceByUri(uri, std::move(text));
 	}
 
-	compileAndUpdateDiagnostics();
+	m_diagnosticsOutdated = true;
 }
 
 void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
@@ -545,7 +728,7 @@ void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
 	string uri = _args["textDocument"]["uri"].asString();
 	m_openFiles.erase(uri);
 
-	compileAndUpdateDiagnostics();
+	m_diagnosticsOutdated = true;
 }
 
 ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
@@ -564,5 +747,18 @@ tuple<ASTNode const*, int> LanguageServer::astNodeAndOffsetAtSourceLocation(std:
 	if (!sourcePos)
 		return {nullptr, -1};
 
-	return {locateInnermostASTNode(*sourcePos, m_compilerStack.ast(_sourceUnitName)), *sourcePos};
+	return {astIndex().innermostNode(_sourceUnitName, *sourcePos), *sourcePos};
+}
+
+ASTIndex const& LanguageServer::astIndex()
+{
+	solAssert(m_compilerStack.state() >= CompilerStack::AnalysisPerformed);
+	if (!m_astIndex)
+	{
+		vector<SourceUnit const*> sourceUnits;
+		for (string const& sourceName: m_compilerStack.sourceNames())
+			sourceUnits.push_back(&m_compilerStack.ast(sourceName));
+		m_astIndex.emplace(sourceUnits);
+	}
+	return *m_astIndex;
 }
@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <libsolidity/lsp/ASTIndex.h>
 #include <libsolidity/lsp/Transport.h>
 #include <libsolidity/lsp/FileRepository.h>
 #include <libsolidity/interface/CompilerStack.h>
@@ -24,6 +25,7 @@
 
 #include <json/value.h>
 
+#include <ctime>
 #include <functional>
 #include <map>
 #include <optional>
@@ -80,6 +82,9 @@ public:
 	std::tuple<frontend::ASTNode const*, int> astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
+	/// @returns the index of the ASTs of the last analysis, which is built on first use.
+	/// Requires the analysis to have been performed.
+	ASTIndex const& astIndex();
 
 private:
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
@@ -95,12 +100,34 @@ private:
 	void handleRename(Json::Value const& _args);
 	void handleGotoDefinition(MessageID _id, Json::Value const& _args);
 	void semanticTokensFull(MessageID _id, Json::Value const& _args);
+	void semanticTokensFullDelta(MessageID _id, Json::Value const& _args);
+	void semanticTokensRange(MessageID _id, Json::Value const& _args);
+
+	/// Semantic tokens of a source unit, encoded as sent to the client.
+	struct SemanticTokens
+	{
+		/// Identifies the tokens towards the client. Increased whenever they are rebuilt.
+		unsigned version = 0;
+		Json::Value data;
+		/// False if the tokens were built from an analysis of different sources
+		/// and have to be rebuilt before they are used again.
+		bool upToDate = false;
+	};
+	/// @returns the semantic tokens of the source unit @a _sourceUnitName,
+	/// which are only built if they are not up to date.
+	SemanticTokens const& semanticTokens(std::string const& _sourceUnitName);
+	/// Marks the cached semantic tokens as outdated if they could differ after the last analysis.
+	/// @param _previousSources the sources analyzed before, or nullptr if that analysis failed.
+	void invalidateSemanticTokens(StringMap const* _previousSources);
 
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json::Value const&);
 
 	/// Compile everything until after analysis phase.
+	/// Does nothing if none of the sources used in the previous compilation changed.
 	void compile();
+	/// @returns true if the sources that were analyzed in the last compilation are still the same.
+	bool analyzedSourcesUpToDate() const;
 
 	std::vector<boost::filesystem::path> allSolidityFilesFromProject() const;
 
@@ -125,6 +152,22 @@ private:
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
 
 	frontend::CompilerStack m_compilerStack;
+	/// All sources, including imported ones, as they were used in the last compilation.
+	/// Reset if the configuration changes.
+	std::optional<StringMap> m_analyzedSources;
+	/// Sources of the last compilation that were loaded through imports, i.e. that are neither open nor
+	/// part of the project, with the path they were read from and its modification time at that point.
+	std::map<std::string, std::pair<boost::filesystem::path, std::time_t>> m_importedFiles;
+	/// Time at which the last compilation started.
+	std::time_t m_analysisTime = 0;
+	/// Index of the ASTs of the last compilation, reset whenever the sources are analyzed again.
+	std::optional<ASTIndex> m_astIndex;
+	/// Semantic tokens per source unit name, built on request.
+	std::map<std::string, SemanticTokens> m_semanticTokens;
+	/// Set if the sources changed since the diagnostics were last published.
+	/// Reporting the new diagnostics is postponed until the client stops sending changes
+	/// or sends a request, so that analysis does not run on every single keystroke.
+	bool m_diagnosticsOutdated = false;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json::Value m_settingsObject;
@@ -0,0 +1,52 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/References.h>
+#include <libsolidity/lsp/Utils.h>
+#include <libsolidity/ast/AST.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+using namespace std;
+
+void References::operator()(MessageID _id, Json::Value const& _args)
+{
+	auto const [sourceUnitName, lineColumn] = extractSourceUnitNameAndLineColumn(_args);
+	bool const includeDeclaration = _args["context"].get("includeDeclaration", true).asBool();
+
+	auto const [sourceNode, cursorBytePosition] = m_server.astNodeAndOffsetAtSourceLocation(sourceUnitName, lineColumn);
+
+	vector<SourceLocation> locations;
+	if (sourceNode)
+		if (auto const* declaration = symbolAtOffset(*sourceNode, cursorBytePosition).first)
+			for (ASTIndex::Reference const& reference: m_server.astIndex().references(*declaration))
+				if (includeDeclaration || reference.location != declaration->nameLocation())
+					locations.emplace_back(reference.location);
+
+	sort(locations.begin(), locations.end());
+	locations.erase(unique(locations.begin(), locations.end()), locations.end());
+
+	Json::Value reply = Json::arrayValue;
+	for (SourceLocation const& location: locations)
+		reply.append(toJson(location));
+	client().reply(_id, reply);
+}
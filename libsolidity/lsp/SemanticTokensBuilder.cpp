@@ -23,6 +23,8 @@
 
 #include <fmt/format.h>
 
+#include <tuple>
+
 using namespace std;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
@@ -280,4 +282,63 @@ bool SemanticTokensBuilder::visit(frontend::VariableDeclaration const& _node)
 	return false;
 }
 
+Json::Value semanticTokensInRange(Json::Value const& _data, LineColumn const& _start, LineColumn const& _end)
+{
+	Json::Value tokens = Json::arrayValue;
+	int line = 0;
+	int startChar = 0;
+	int lastLine = 0;
+	int lastStartChar = 0;
+	for (Json::ArrayIndex i = 0; i + 4 < _data.size(); i += 5)
+	{
+		// Decode the absolute position the same way the client does.
+		int const deltaLine = _data[i].asInt();
+		line += deltaLine;
+		startChar = deltaLine == 0 ? startChar + _data[i + 1].asInt() : _data[i + 1].asInt();
+
+		if (
+			make_tuple(line, startChar) < make_tuple(_start.line, _start.column) ||
+			make_tuple(line, startChar) >= make_tuple(_end.line, _end.column)
+		)
+			continue;
+
+		tokens.append(line - lastLine);
+		tokens.append(line == lastLine ? startChar - lastStartChar : startChar);
+		for (Json::ArrayIndex j = 2; j < 5; j++)
+			tokens.append(_data[i + j]);
+
+		lastLine = line;
+		lastStartChar = startChar;
+	}
+	return tokens;
+}
+
+Json::Value semanticTokensEdits(Json::Value const& _previous, Json::Value const& _current)
+{
+	Json::ArrayIndex prefix = 0;
+	while (prefix < _previous.size() && prefix < _current.size() && _previous[prefix] == _current[prefix])
+		prefix++;
+
+	Json::ArrayIndex suffix = 0;
+	while (
+		prefix + suffix < _previous.size() &&
+		prefix + suffix < _current.size() &&
+		_previous[_previous.size() - 1 - suffix] == _current[_current.size() - 1 - suffix]
+	)
+		suffix++;
+
+	Json::Value edits = Json::arrayValue;
+	if (prefix + suffix < _previous.size() || prefix + suffix < _current.size())
+	{
+		Json::Value edit = Json::objectValue;
+		edit["start"] = prefix;
+		edit["deleteCount"] = _previous.size() - prefix - suffix;
+		edit["data"] = Json::arrayValue;
+		for (Json::ArrayIndex i = prefix; i < _current.size() - suffix; i++)
+			edit["data"].append(_current[i]);
+		edits.append(edit);
+	}
+	return edits;
+}
+
 } // end namespace
@@ -24,6 +24,7 @@
 namespace solidity::langutil
 {
 class CharStream;
+struct LineColumn;
 struct SourceLocation;
 }
 
@@ -120,4 +121,16 @@ private:
 	int m_lastStartChar;
 };
 
+/// @returns the tokens of @a _data, as encoded by the SemanticTokensBuilder, that start
+/// at or after @a _start and before @a _end, encoded as if they were the only tokens.
+Json::Value semanticTokensInRange(
+	Json::Value const& _data,
+	langutil::LineColumn const& _start,
+	langutil::LineColumn const& _end
+);
+
+/// @returns the edits that transform the encoded tokens @a _previous into @a _current.
+/// These consist of at most one edit that replaces the part between the common prefix and suffix.
+Json::Value semanticTokensEdits(Json::Value const& _previous, Json::Value const& _current);
+
 } // end namespace
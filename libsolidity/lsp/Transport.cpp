@@ -27,14 +27,19 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <cerrno>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
 
 
 #if defined(_WIN32)
 #include <io.h>
 #include <fcntl.h>
+#else
+#include <poll.h>
+#include <unistd.h>
 #endif
 
 using namespace std;
@@ -155,6 +160,19 @@ bool IOStreamTransport::closed() const noexcept
 	return m_input.eof();
 }
 
+bool IOStreamTransport::waitForInput(std::chrono::milliseconds _timeout)
+{
+	auto const deadline = chrono::steady_clock::now() + _timeout;
+	while (true)
+	{
+		if (m_input.rdbuf() && m_input.rdbuf()->in_avail() > 0)
+			return true;
+		if (m_input.eof() || chrono::steady_clock::now() >= deadline)
+			return false;
+		this_thread::sleep_for(chrono::milliseconds(1));
+	}
+}
+
 std::string IOStreamTransport::readBytes(size_t _length)
 {
 	return util::readBytes(m_input, _length);
@@ -189,23 +207,72 @@ StdioTransport::StdioTransport()
 
 bool StdioTransport::closed() const noexcept
 {
-	return feof(stdin);
+	return m_endOfInput && m_inputPosition == m_input.size();
+}
+
+bool StdioTransport::waitForInput([[maybe_unused]] std::chrono::milliseconds _timeout)
+{
+	if (m_inputPosition < m_input.size())
+		return true;
+	#if defined(_WIN32)
+	return false;
+	#else
+	pollfd input{fileno(stdin), POLLIN, 0};
+	return poll(&input, 1, static_cast<int>(_timeout.count())) > 0;
+	#endif
+}
+
+bool StdioTransport::readInput()
+{
+	if (m_endOfInput)
+		return false;
+
+	m_input.erase(0, m_inputPosition);
+	m_inputPosition = 0;
+
+	char buffer[65536];
+	#if defined(_WIN32)
+	int const bytesRead = _read(_fileno(stdin), buffer, static_cast<unsigned>(sizeof(buffer)));
+	#else
+	ssize_t bytesRead = 0;
+	do
+		bytesRead = read(fileno(stdin), buffer, sizeof(buffer));
+	while (bytesRead < 0 && errno == EINTR);
+	#endif
+	if (bytesRead <= 0)
+	{
+		m_endOfInput = true;
+		return false;
+	}
+	m_input.append(buffer, static_cast<size_t>(bytesRead));
+	return true;
 }
 
 std::string StdioTransport::readBytes(size_t _byteCount)
 {
-	std::string buffer;
-	buffer.resize(_byteCount);
-	auto const n = fread(buffer.data(), 1, _byteCount, stdin);
-	if (n < _byteCount)
-		buffer.resize(n);
-	return buffer;
+	while (m_input.size() - m_inputPosition < _byteCount)
+		if (!readInput())
+			break;
+	std::string bytes = m_input.substr(m_inputPosition, _byteCount);
+	m_inputPosition += bytes.size();
+	return bytes;
 }
 
 std::string StdioTransport::getline()
 {
-	std::string line;
-	std::getline(std::cin, line);
+	size_t lineEnd = m_input.find('\n', m_inputPosition);
+	while (lineEnd == std::string::npos)
+	{
+		// Reading more input moves the unconsumed part to the beginning of the buffer.
+		size_t const searched = m_input.size() - m_inputPosition;
+		if (!readInput())
+			break;
+		lineEnd = m_input.find('\n', searched);
+	}
+
+	size_t const lineLength = (lineEnd == std::string::npos ? m_input.size() : lineEnd) - m_inputPosition;
+	std::string line = m_input.substr(m_inputPosition, lineLength);
+	m_inputPosition = std::min(m_input.size(), m_inputPosition + lineLength + 1);
 	lspDebug(fmt::format("Received: {}", line));
 	return line;
 }
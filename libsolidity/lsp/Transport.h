@@ -21,6 +21,7 @@
 
 #include <json/value.h>
 
+#include <chrono>
 #include <functional>
 #include <iosfwd>
 #include <map>
@@ -105,6 +106,11 @@ public:
 
 	virtual bool closed() const noexcept = 0;
 
+	/// Waits at most @p _timeout for input to arrive.
+	/// @returns true if there is input that can be received without blocking.
+	/// Transports that cannot tell return false without waiting.
+	virtual bool waitForInput(std::chrono::milliseconds _timeout) = 0;
+
 	void trace(std::string _message, Json::Value _extra = Json::nullValue);
 
 	TraceValue traceValue() const noexcept { return m_logTrace; }
@@ -151,6 +157,9 @@ public:
 	IOStreamTransport(std::istream& _in, std::ostream& _out);
 
 	bool closed() const noexcept override;
+	/// Streams cannot notify about new input, so this checks the input that is available
+	/// without blocking repeatedly until the timeout expires.
+	bool waitForInput(std::chrono::milliseconds _timeout) override;
 
 protected:
 	std::string readBytes(size_t _byteCount) override;
@@ -172,12 +181,24 @@ public:
 	StdioTransport();
 
 	bool closed() const noexcept override;
+	bool waitForInput(std::chrono::milliseconds _timeout) override;
 
 protected:
 	std::string readBytes(size_t _byteCount) override;
 	std::string getline() override;
 	void writeBytes(std::string_view _data) override;
 	void flushOutput() override;
+
+private:
+	/// Appends the input that is available to m_input, blocking until there is some.
+	/// @returns false if the end of the input was reached.
+	bool readInput();
+
+	/// Input read from stdin in large chunks that was not consumed yet. It is buffered here
+	/// rather than by stdio so that waitForInput() can take it into account.
+	std::string m_input;
+	size_t m_inputPosition = 0;
+	bool m_endOfInput = false;
 };
 
 }
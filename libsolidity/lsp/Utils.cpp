@@ -21,6 +21,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/lsp/FileRepository.h>
 #include <libsolidity/lsp/Utils.h>
+#include <libyul/AST.h>
 
 #include <regex>
 #include <fstream>
@@ -84,6 +85,81 @@ optional<SourceLocation> declarationLocation(Declaration const* _declaration)
 	return nullopt;
 }
 
+FunctionDefinition const* calledFunctionDefinition(FunctionCall const& _functionCall)
+{
+	if (
+		auto const* functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type);
+		functionType && functionType->hasDeclaration()
+	)
+		return dynamic_cast<FunctionDefinition const*>(&functionType->declaration());
+
+	return nullptr;
+}
+
+pair<Declaration const*, string> symbolAtOffset(ASTNode const& _node, int _offset)
+{
+	if (auto const* declaration = dynamic_cast<Declaration const*>(&_node))
+	{
+		if (declaration->nameLocation().containsOffset(_offset))
+			return {declaration, declaration->name()};
+		else if (auto const* importDirective = dynamic_cast<ImportDirective const*>(declaration))
+			for (ImportDirective::SymbolAlias const& symbolAlias: importDirective->symbolAliases())
+				if (symbolAlias.location.containsOffset(_offset))
+				{
+					solAssert(symbolAlias.alias);
+					return {symbolAlias.symbol->annotation().referencedDeclaration, *symbolAlias.alias};
+				}
+	}
+	else if (auto const* identifier = dynamic_cast<Identifier const*>(&_node))
+	{
+		if (auto const* referencedDeclaration = identifier->annotation().referencedDeclaration)
+			return {referencedDeclaration, identifier->name()};
+	}
+	else if (auto const* identifierPath = dynamic_cast<IdentifierPath const*>(&_node))
+	{
+		// iterate through the elements of the path to find the one the cursor is on
+		size_t numIdentifiers = identifierPath->pathLocations().size();
+		solAssert(identifierPath->annotation().pathDeclarations.size() == numIdentifiers);
+		solAssert(identifierPath->path().size() == numIdentifiers);
+		for (size_t i = 0; i < numIdentifiers; i++)
+			if (identifierPath->pathLocations()[i].containsOffset(_offset))
+				return {identifierPath->annotation().pathDeclarations[i], identifierPath->path()[i]};
+	}
+	else if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(&_node))
+	{
+		if (auto const* referencedDeclaration = memberAccess->annotation().referencedDeclaration)
+			return {referencedDeclaration, memberAccess->memberName()};
+	}
+	else if (auto const* functionCall = dynamic_cast<FunctionCall const*>(&_node))
+	{
+		if (auto const* functionDefinition = calledFunctionDefinition(*functionCall))
+			for (size_t i = 0; i < functionCall->names().size(); i++)
+				if (functionCall->nameLocations()[i].containsOffset(_offset))
+				{
+					for (auto const& parameter: functionDefinition->parameters())
+						if (parameter && parameter->name() == *functionCall->names()[i])
+							return {parameter.get(), parameter->name()};
+					break;
+				}
+	}
+	else if (auto const* inlineAssembly = dynamic_cast<InlineAssembly const*>(&_node))
+		for (auto&& [yulIdentifier, externalReference]: inlineAssembly->annotation().externalReferences)
+		{
+			SourceLocation location = yul::nativeLocationOf(*yulIdentifier);
+			location.end -= static_cast<int>(externalReference.suffix.size() + 1);
+
+			if (location.containsOffset(_offset))
+			{
+				string name = yulIdentifier->name.str();
+				if (!externalReference.suffix.empty())
+					name = name.substr(0, name.length() - externalReference.suffix.size() - 1);
+				return {externalReference.declaration, std::move(name)};
+			}
+		}
+
+	return {nullptr, {}};
+}
+
 optional<SourceLocation> parsePosition(
 	FileRepository const& _fileRepository,
 	string const& _sourceUnitName,
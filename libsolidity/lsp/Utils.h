@@ -25,6 +25,8 @@
 #include <libsolutil/JSON.h>
 
 #include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 #if !defined(NDEBUG)
@@ -83,4 +85,14 @@ frontend::Declaration const* referencedDeclaration(frontend::Expression const* _
 /// declaration otherwise. If the input declaration is nullptr, std::nullopt is returned instead.
 std::optional<langutil::SourceLocation> declarationLocation(frontend::Declaration const* _declaration);
 
+/// @returns the definition of the function called by @a _functionCall, if it is known.
+frontend::FunctionDefinition const* calledFunctionDefinition(frontend::FunctionCall const& _functionCall);
+
+/// Extracts the symbol at the given offset, which has to lie within @a _node,
+/// the innermost AST node containing it.
+///
+/// @returns the declaration the symbol refers to and the name it is referred to by at the offset,
+/// or nullptr and an empty name if there is no symbol at the offset.
+std::pair<frontend::Declaration const*, std::string> symbolAtOffset(frontend::ASTNode const& _node, int _offset);
+
 }
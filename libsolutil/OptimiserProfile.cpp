@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/OptimiserProfile.h>
+
+using namespace std;
+using namespace std::chrono;
+using namespace solidity;
+using namespace solidity::util;
+
+OptimiserProfile::Measurement::Measurement(
+	OptimiserProfile* _profile,
+	string _object,
+	string _step,
+	function<size_t()> _codeSize
+):
+	m_profile(_profile),
+	m_object(std::move(_object)),
+	m_step(std::move(_step)),
+	m_codeSize(std::move(_codeSize))
+{
+	if (!m_profile)
+		return;
+	m_sizeBefore = m_codeSize();
+	m_start = steady_clock::now();
+}
+
+OptimiserProfile::Measurement::~Measurement()
+{
+	if (!m_profile)
+		return;
+	auto duration = duration_cast<microseconds>(steady_clock::now() - m_start);
+	m_profile->record(m_object, m_step, duration, m_sizeBefore, m_codeSize());
+}
+
+void OptimiserProfile::record(
+	string const& _object,
+	string const& _step,
+	microseconds _duration,
+	size_t _sizeBefore,
+	size_t _sizeAfter
+)
+{
+	lock_guard<mutex> lock(m_mutex);
+	StepStatistics& statistics = m_objects[_object][_step];
+	statistics.invocations++;
+	statistics.duration += _duration;
+	statistics.sizeBefore += _sizeBefore;
+	statistics.sizeAfter += _sizeAfter;
+}
+
+Json::Value OptimiserProfile::toJson() const
+{
+	Json::Value ret(Json::objectValue);
+	for (auto const& [object, steps]: m_objects)
+	{
+		Json::Value& objectData = ret[object] = Json::objectValue;
+		for (auto const& [step, statistics]: steps)
+		{
+			Json::Value& stepData = objectData[step];
+			stepData["invocations"] = Json::UInt64(statistics.invocations);
+			stepData["durationMicroseconds"] = Json::Int64(statistics.duration.count());
+			stepData["sizeBefore"] = Json::UInt64(statistics.sizeBefore);
+			stepData["sizeAfter"] = Json::UInt64(statistics.sizeAfter);
+		}
+	}
+	return ret;
+}
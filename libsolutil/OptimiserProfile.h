@@ -0,0 +1,102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Collection of run time statistics of optimiser steps.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace solidity::util
+{
+
+/**
+ * Statistics about the optimiser steps that were run, grouped by the object they were run on.
+ *
+ * Code sizes are given in the unit natural to the respective optimiser, i.e. the number of
+ * AST nodes for the Yul optimiser and the number of assembly items for the EVM assembly optimiser.
+ * Steps that are run multiple times on the same object are accumulated.
+ * Measurements can be recorded from multiple threads at once.
+ */
+class OptimiserProfile
+{
+public:
+	struct StepStatistics
+	{
+		size_t invocations = 0;
+		std::chrono::microseconds duration{0};
+		/// Sum of the code sizes before each invocation.
+		size_t sizeBefore = 0;
+		/// Sum of the code sizes after each invocation.
+		size_t sizeAfter = 0;
+	};
+
+	/// Measures the time between its construction and destruction and records it as one
+	/// invocation of a step together with the code sizes at these two points.
+	/// Does nothing if the profile is null, so that it can be used unconditionally.
+	class Measurement
+	{
+	public:
+		Measurement(
+			OptimiserProfile* _profile,
+			std::string _object,
+			std::string _step,
+			std::function<size_t()> _codeSize
+		);
+		~Measurement();
+
+		Measurement(Measurement const&) = delete;
+		Measurement& operator=(Measurement const&) = delete;
+
+	private:
+		OptimiserProfile* m_profile = nullptr;
+		std::string m_object;
+		std::string m_step;
+		std::function<size_t()> m_codeSize;
+		size_t m_sizeBefore = 0;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+	void record(
+		std::string const& _object,
+		std::string const& _step,
+		std::chrono::microseconds _duration,
+		size_t _sizeBefore,
+		size_t _sizeAfter
+	);
+
+	/// @returns the statistics per object name and step name.
+	std::map<std::string, std::map<std::string, StepStatistics>> const& objects() const { return m_objects; }
+
+	/// @returns the statistics in the form
+	/// {"<object>": {"<step>": {"invocations": ..., "durationMicroseconds": ..., "sizeBefore": ..., "sizeAfter": ...}}}.
+	Json::Value toJson() const;
+
+private:
+	std::map<std::string, std::map<std::string, StepStatistics>> m_objects;
+	std::mutex m_mutex;
+};
+
+}
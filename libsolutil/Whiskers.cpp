@@ -26,15 +26,58 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <string_view>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
 
+/// Template split into text and tags. The bodies of lists and conditions are parsed recursively.
+struct Whiskers::Template
+{
+	struct Node
+	{
+		enum class Kind { Text, Parameter, List, Condition };
+
+		Kind kind = Kind::Text;
+		/// The text or the name of the parameter, including the "+" of conditional value parameters.
+		string value;
+		/// The body of a list or the part of a condition that is used if the condition is true.
+		unique_ptr<Template const> body;
+		/// The part of a condition that is used if the condition is false. Might be null.
+		unique_ptr<Template const> elseBody;
+	};
+
+	/// The unparsed template, used in error messages.
+	string source;
+	vector<Node> nodes;
+};
+
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the position after the longest sequence of parameter characters starting at @a _pos.
+size_t parameterEnd(string const& _string, size_t _pos)
+{
+	while (_pos < _string.size() && isParameterCharacter(_string[_pos]))
+		_pos++;
+	return _pos;
+}
+
+}
+
 Whiskers::Whiskers(string _template):
-	m_template(std::move(_template))
+	m_template(parsedTemplate(_template))
 {
-	checkTemplateValid();
 }
 
 Whiskers& Whiskers::operator()(string _parameter, string _value)
@@ -72,25 +115,37 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	string result;
+	result.reserve(m_template->source.size());
+	render(*m_template, result, m_parameters, m_conditions, m_listParameters);
+	return result;
 }
 
-void Whiskers::checkTemplateValid() const
+void Whiskers::checkTemplateValid(string const& _template)
 {
-	regex validTemplate("<[#?!\\/]\\+{0,1}[a-zA-Z0-9_$-]+(?:[^a-zA-Z0-9_$>-]|$)");
-	smatch match;
-	assertThrow(
-		!regex_search(m_template, match, validTemplate),
-		WhiskersError,
-		"Template contains an invalid/unclosed tag " + match.str()
-	);
+	// Looks for tags that start like a list or condition tag but are not closed right after the name.
+	for (size_t pos = _template.find('<'); pos != string::npos; pos = _template.find('<', pos + 1))
+	{
+		if (pos + 1 == _template.size() || string_view("#?!/").find(_template[pos + 1]) == string_view::npos)
+			continue;
+		size_t nameStart = pos + 2;
+		if (nameStart < _template.size() && _template[nameStart] == '+')
+			nameStart++;
+		size_t nameEnd = parameterEnd(_template, nameStart);
+		if (nameEnd == nameStart || (nameEnd < _template.size() && _template[nameEnd] == '>'))
+			continue;
+		assertThrow(
+			false,
+			WhiskersError,
+			"Template contains an invalid/unclosed tag " + _template.substr(pos, nameEnd + 1 - pos)
+		);
+	}
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && parameterEnd(_parameter, 0) == _parameter.size(),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -121,86 +176,153 @@ void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string
 	{
 		string tag{"<" + prefix + _parameter + ">"};
 		assertThrow(
-			m_template.find(tag) != string::npos,
+			m_template->source.find(tag) != string::npos,
 			WhiskersError,
-			"Tag '" + tag + "' not found in template:\n" + m_template
+			"Tag '" + tag + "' not found in template:\n" + m_template->source
 		);
 	}
 }
 
-namespace
+shared_ptr<Whiskers::Template const> Whiskers::parsedTemplate(string const& _template)
 {
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+	// Almost all templates are string literals, so there are only a few hundred distinct ones.
+	// The limit just prevents unbounded growth in long-running processes if that is not the case.
+	static size_t constexpr maxCacheSize = 4096;
+	// The keys point into the sources of the cached templates.
+	// Each thread has its own cache, so that it can be used without locking.
+	thread_local unordered_map<string_view, shared_ptr<Template const>> cache;
+
+	if (auto it = cache.find(_template); it != cache.end())
+		return it->second;
+
+	checkTemplateValid(_template);
+	shared_ptr<Template const> parsed = parse(_template);
+	if (cache.size() >= maxCacheSize)
+		cache.clear();
+	cache.emplace(parsed->source, parsed);
+	return parsed;
+}
+
+unique_ptr<Whiskers::Template const> Whiskers::parse(string _template)
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
+	// This recognizes the same tags as matching the template against the regular expression
+	//   <(name)>|<#(name)>(.*?)</\2>|<\?(\+?name)>(.*?)(<!\4>(.*?))?</\4>
+	// from left to right, where name is [a-zA-Z0-9_$-]+. Tags that are not closed are treated as text.
+	auto result = make_unique<Template>();
+	result->source = std::move(_template);
+	string const& source = result->source;
+
+	size_t textStart = 0;
+	auto appendText = [&](size_t _end) {
+		if (_end > textStart)
+			result->nodes.push_back({Template::Node::Kind::Text, source.substr(textStart, _end - textStart), nullptr, nullptr});
+	};
+
+	size_t pos = 0;
+	while ((pos = source.find('<', pos)) != string::npos)
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		char const marker = pos + 1 < source.size() ? source[pos + 1] : '\0';
+		bool const isList = (marker == '#');
+		bool const isCondition = (marker == '?');
+		size_t const nameStart = (isList || isCondition) ? pos + 2 : pos + 1;
+		size_t const identifierStart =
+			(isCondition && nameStart < source.size() && source[nameStart] == '+') ?
+			nameStart + 1 :
+			nameStart;
+		size_t const nameEnd = parameterEnd(source, identifierStart);
+		if (nameEnd == identifierStart || nameEnd == source.size() || source[nameEnd] != '>')
+		{
+			pos++;
+			continue;
+		}
+
+		Template::Node node;
+		node.value = source.substr(nameStart, nameEnd - nameStart);
+		size_t const bodyStart = nameEnd + 1;
+		size_t end = bodyStart;
+		if (isList || isCondition)
+		{
+			string const closingTag = "</" + node.value + ">";
+			size_t const closingTagPos = source.find(closingTag, bodyStart);
+			if (closingTagPos == string::npos)
+			{
+				pos++;
+				continue;
+			}
+			end = closingTagPos + closingTag.size();
+
+			size_t bodyEnd = closingTagPos;
+			if (isCondition)
+			{
+				node.kind = Template::Node::Kind::Condition;
+				string const elseTag = "<!" + node.value + ">";
+				size_t const elseTagPos = source.find(elseTag, bodyStart);
+				if (elseTagPos < closingTagPos)
+				{
+					bodyEnd = elseTagPos;
+					size_t const elseStart = elseTagPos + elseTag.size();
+					node.elseBody = parse(source.substr(elseStart, closingTagPos - elseStart));
+				}
+			}
+			else
+				node.kind = Template::Node::Kind::List;
+			node.body = parse(source.substr(bodyStart, bodyEnd - bodyStart));
+		}
+		else
+			node.kind = Template::Node::Kind::Parameter;
+
+		appendText(pos);
+		result->nodes.emplace_back(std::move(node));
+		pos = textStart = end;
 	}
-	result.append(lastMatchedPos, _source.cend());
+	appendText(source.size());
 	return result;
 }
-}
 
-string Whiskers::replace(
-	string const& _template,
+void Whiskers::render(
+	Template const& _template,
+	string& _output,
 	StringMap const& _parameters,
 	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
+	StringListMap const& _listParameters
 )
 {
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
+	for (Template::Node const& node: _template.nodes)
+		switch (node.kind)
 		{
+		case Template::Node::Kind::Text:
+			_output += node.value;
+			break;
+		case Template::Node::Kind::Parameter:
+		{
+			auto parameter = _parameters.find(node.value);
 			assertThrow(
-				_parameters.count(tagName),
+				parameter != _parameters.end(),
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + node.value + " not provided.\n" +
 				"Template:\n" +
-				_template
+				_template.source
 			);
-			return _parameters.at(tagName);
+			_output += parameter->second;
+			break;
 		}
-		else if (!listName.empty())
+		case Template::Node::Kind::List:
 		{
-			string templ(_match[3]);
+			auto list = _listParameters.find(node.value);
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				list != _listParameters.end(),
+				WhiskersError, "List parameter " + node.value + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			for (auto const& parameters: list->second)
+				render(*node.body, _output, joinMaps(_parameters, parameters), _conditions, {});
+			break;
 		}
-		else
+		case Template::Node::Kind::Condition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
+			if (node.value[0] == '+')
 			{
-				string tag = conditionName.substr(1);
+				string tag = node.value.substr(1);
 
 				if (_parameters.count(tag))
 					conditionValue = !_parameters.at(tag).empty();
@@ -212,19 +334,16 @@ string Whiskers::replace(
 			else
 			{
 				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
+					_conditions.count(node.value),
+					WhiskersError, "Condition parameter " + node.value + " not set."
 				);
-				conditionValue = _conditions.at(conditionName);
+				conditionValue = _conditions.at(node.value);
 			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
+			if (Template const* part = conditionValue ? node.body.get() : node.elseBody.get())
+				render(*part, _output, _parameters, _conditions, _listParameters);
+			break;
+		}
 		}
-	});
 }
 
 Whiskers::StringMap Whiskers::joinMaps(
@@ -241,4 +360,3 @@ Whiskers::StringMap Whiskers::joinMaps(
 		);
 	return ret;
 }
-
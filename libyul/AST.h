@@ -28,8 +28,12 @@
 
 #include <liblangutil/SourceLocation.h>
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -48,17 +52,16 @@ struct DebugData
 		astID(std::move(_astID))
 	{}
 
-	static std::shared_ptr<DebugData const> create(
+	/// @returns a handle to the stored debug data equal to the given one.
+	static DebugDataHandle create(
 		langutil::SourceLocation _nativeLocation = {},
 		langutil::SourceLocation _originLocation = {},
 		std::optional<int64_t> _astID = {}
-	)
+	);
+
+	bool operator==(DebugData const& _other) const
 	{
-		return std::make_shared<DebugData const>(
-			std::move(_nativeLocation),
-			std::move(_originLocation),
-			std::move(_astID)
-		);
+		return nativeLocation == _other.nativeLocation && originLocation == _other.originLocation && astID == _other.astID;
 	}
 
 	/// Location in the Yul code.
@@ -70,43 +73,176 @@ struct DebugData
 	std::optional<int64_t> astID;
 };
 
-struct TypedName { std::shared_ptr<DebugData const> debugData; YulString name; Type type; };
+/// Reference to debug data in the DebugDataRepository, or to no debug data at all.
+/// It takes four bytes and can be copied without any reference counting.
+class DebugDataHandle
+{
+public:
+	DebugDataHandle() = default;
+	DebugDataHandle(std::nullptr_t) {}
+
+	/// @returns the referenced debug data or nullptr if there is none.
+	DebugData const* get() const;
+	DebugData const& operator*() const { return *get(); }
+	DebugData const* operator->() const { return get(); }
+	explicit operator bool() const { return m_id != 0; }
+
+	/// Equality of handles is equality of the debug data, because equal debug data is only stored once.
+	bool operator==(DebugDataHandle const& _other) const { return m_id == _other.m_id; }
+	bool operator!=(DebugDataHandle const& _other) const { return m_id != _other.m_id; }
+
+private:
+	friend class DebugDataRepository;
+	explicit DebugDataHandle(uint32_t _id): m_id(_id) {}
+
+	/// Index into the repository. Zero refers to no debug data.
+	uint32_t m_id = 0;
+};
+
+/// Repository for the debug data of Yul AST nodes.
+/// Stores every distinct DebugData once, so that nodes with the same locations share it.
+/// It is cleared together with the YulStringRepository and has the same restrictions.
+/// Storing debug data is synchronised, reading it does not require locking,
+/// because stored debug data is never moved.
+class DebugDataRepository
+{
+public:
+	static DebugDataRepository& instance()
+	{
+		static DebugDataRepository inst;
+		return inst;
+	}
+
+	DebugDataHandle store(DebugData _debugData)
+	{
+		size_t const hash = hashOf(_debugData);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto range = m_hashToID.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it)
+			if ((*this)[it->second] == _debugData)
+				return DebugDataHandle{it->second};
+		uint32_t const id = push_back(std::move(_debugData));
+		m_hashToID.emplace_hint(range.second, hash, id);
+		return DebugDataHandle{id};
+	}
+
+	DebugData const& operator[](uint32_t _id) const
+	{
+		return *m_segments[_id >> segmentBits][_id & (segmentSize - 1)];
+	}
+
+private:
+	DebugDataRepository()
+	{
+		clear();
+		static YulStringRepository::ResetCallback callback{[] {
+			DebugDataRepository& repository = instance();
+			std::lock_guard<std::mutex> lock(repository.m_mutex);
+			repository.clear();
+		}};
+	}
+	DebugDataRepository(DebugDataRepository const&) = delete;
+	DebugDataRepository& operator=(DebugDataRepository const&) = delete;
+
+	static size_t hashOf(DebugData const& _debugData)
+	{
+		size_t hash = std::hash<int64_t>{}(_debugData.astID.value_or(-1));
+		for (langutil::SourceLocation const* location: {&_debugData.nativeLocation, &_debugData.originLocation})
+		{
+			hash = hash * 31 + std::hash<int>{}(location->start);
+			hash = hash * 31 + std::hash<int>{}(location->end);
+			if (location->sourceName)
+				hash = hash * 31 + std::hash<std::string>{}(*location->sourceName);
+		}
+		return hash;
+	}
+
+	uint32_t push_back(DebugData _debugData)
+	{
+		size_t const segment = m_size >> segmentBits;
+		assertThrow(segment < m_segments.size(), util::Exception, "Too many distinct Yul debug data.");
+		if (!m_segments[segment])
+			m_segments[segment] = std::make_unique<std::optional<DebugData>[]>(segmentSize);
+		m_segments[segment][m_size & (segmentSize - 1)].emplace(std::move(_debugData));
+		return m_size++;
+	}
+
+	/// Frees all debug data, but keeps the first segment allocated.
+	/// Slot zero stays unused, because the ID zero refers to no debug data.
+	void clear()
+	{
+		for (size_t segment = 1; segment < m_segments.size() && m_segments[segment]; segment++)
+			m_segments[segment].reset();
+		if (m_segments[0])
+			for (size_t i = 0; i < std::min<size_t>(m_size, segmentSize); i++)
+				m_segments[0][i].reset();
+		m_hashToID.clear();
+		m_size = 1;
+	}
+
+	static constexpr size_t segmentBits = 12;
+	static constexpr size_t segmentSize = size_t(1) << segmentBits;
+	std::array<std::unique_ptr<std::optional<DebugData>[]>, 8192> m_segments;
+	uint32_t m_size = 0;
+	std::unordered_multimap<size_t, uint32_t> m_hashToID;
+	std::mutex m_mutex;
+};
+
+inline DebugData const* DebugDataHandle::get() const
+{
+	return m_id ? &DebugDataRepository::instance()[m_id] : nullptr;
+}
+
+inline DebugDataHandle DebugData::create(
+	langutil::SourceLocation _nativeLocation,
+	langutil::SourceLocation _originLocation,
+	std::optional<int64_t> _astID
+)
+{
+	return DebugDataRepository::instance().store(DebugData(
+		std::move(_nativeLocation),
+		std::move(_originLocation),
+		std::move(_astID)
+	));
+}
+
+struct TypedName { DebugDataHandle debugData; YulString name; Type type; };
 using TypedNameList = std::vector<TypedName>;
 
 /// Literal number or string (up to 32 bytes)
 enum class LiteralKind { Number, Boolean, String };
-struct Literal { std::shared_ptr<DebugData const> debugData; LiteralKind kind; YulString value; Type type; };
+struct Literal { DebugDataHandle debugData; LiteralKind kind; YulString value; Type type; };
 /// External / internal identifier or label reference
-struct Identifier { std::shared_ptr<DebugData const> debugData; YulString name; };
+struct Identifier { DebugDataHandle debugData; YulString name; };
 /// Assignment ("x := mload(20:u256)", expects push-1-expression on the right hand
 /// side and requires x to occupy exactly one stack slot.
 ///
 /// Multiple assignment ("x, y := f()"), where the left hand side variables each occupy
 /// a single stack slot and expects a single expression on the right hand returning
 /// the same amount of items as the number of variables.
-struct Assignment { std::shared_ptr<DebugData const> debugData; std::vector<Identifier> variableNames; std::unique_ptr<Expression> value; };
-struct FunctionCall { std::shared_ptr<DebugData const> debugData; Identifier functionName; std::vector<Expression> arguments; };
+struct Assignment { DebugDataHandle debugData; std::vector<Identifier> variableNames; std::unique_ptr<Expression> value; };
+struct FunctionCall { DebugDataHandle debugData; Identifier functionName; std::vector<Expression> arguments; };
 /// Statement that contains only a single expression
-struct ExpressionStatement { std::shared_ptr<DebugData const> debugData; Expression expression; };
+struct ExpressionStatement { DebugDataHandle debugData; Expression expression; };
 /// Block-scope variable declaration ("let x:u256 := mload(20:u256)"), non-hoisted
-struct VariableDeclaration { std::shared_ptr<DebugData const> debugData; TypedNameList variables; std::unique_ptr<Expression> value; };
+struct VariableDeclaration { DebugDataHandle debugData; TypedNameList variables; std::unique_ptr<Expression> value; };
 /// Block that creates a scope (frees declared stack variables)
-struct Block { std::shared_ptr<DebugData const> debugData; std::vector<Statement> statements; };
+struct Block { DebugDataHandle debugData; std::vector<Statement> statements; };
 /// Function definition ("function f(a, b) -> (d, e) { ... }")
-struct FunctionDefinition { std::shared_ptr<DebugData const> debugData; YulString name; TypedNameList parameters; TypedNameList returnVariables; Block body; };
+struct FunctionDefinition { DebugDataHandle debugData; YulString name; TypedNameList parameters; TypedNameList returnVariables; Block body; };
 /// Conditional execution without "else" part.
-struct If { std::shared_ptr<DebugData const> debugData; std::unique_ptr<Expression> condition; Block body; };
+struct If { DebugDataHandle debugData; std::unique_ptr<Expression> condition; Block body; };
 /// Switch case or default case
-struct Case { std::shared_ptr<DebugData const> debugData; std::unique_ptr<Literal> value; Block body; };
+struct Case { DebugDataHandle debugData; std::unique_ptr<Literal> value; Block body; };
 /// Switch statement
-struct Switch { std::shared_ptr<DebugData const> debugData; std::unique_ptr<Expression> expression; std::vector<Case> cases; };
-struct ForLoop { std::shared_ptr<DebugData const> debugData; Block pre; std::unique_ptr<Expression> condition; Block post; Block body; };
+struct Switch { DebugDataHandle debugData; std::unique_ptr<Expression> expression; std::vector<Case> cases; };
+struct ForLoop { DebugDataHandle debugData; Block pre; std::unique_ptr<Expression> condition; Block post; Block body; };
 /// Break statement (valid within for loop)
-struct Break { std::shared_ptr<DebugData const> debugData; };
+struct Break { DebugDataHandle debugData; };
 /// Continue statement (valid within for loop)
-struct Continue { std::shared_ptr<DebugData const> debugData; };
+struct Continue { DebugDataHandle debugData; };
 /// Leave statement (valid within function)
-struct Leave { std::shared_ptr<DebugData const> debugData; };
+struct Leave { DebugDataHandle debugData; };
 
 /// Extracts the IR source location from a Yul node.
 template <class T> inline langutil::SourceLocation nativeLocationOf(T const& _node)
@@ -133,13 +269,13 @@ template <class... Args> inline langutil::SourceLocation originLocationOf(std::v
 }
 
 /// Extracts the debug data from a Yul node.
-template <class T> inline std::shared_ptr<DebugData const> debugDataOf(T const& _node)
+template <class T> inline DebugDataHandle debugDataOf(T const& _node)
 {
 	return _node.debugData;
 }
 
 /// Extracts the debug data from a Yul node.
-template <class... Args> inline std::shared_ptr<DebugData const> debugDataOf(std::variant<Args...> const& _node)
+template <class... Args> inline DebugDataHandle debugDataOf(std::variant<Args...> const& _node)
 {
 	return std::visit([](auto const& _arg) { return debugDataOf(_arg); }, _node);
 }
@@ -29,6 +29,7 @@ namespace solidity::yul
 {
 
 struct DebugData;
+class DebugDataHandle;
 enum class LiteralKind;
 struct Literal;
 struct Label;
@@ -60,7 +60,7 @@ optional<int> toInt(string const& _value)
 
 }
 
-std::shared_ptr<DebugData const> Parser::createDebugData() const
+DebugDataHandle Parser::createDebugData() const
 {
 	switch (m_useSourceLocationFrom)
 	{
@@ -75,7 +75,7 @@ std::shared_ptr<DebugData const> Parser::createDebugData() const
 }
 
 void Parser::updateLocationEndFrom(
-	shared_ptr<DebugData const>& _debugData,
+	DebugDataHandle& _debugData,
 	SourceLocation const& _location
 ) const
 {
@@ -88,7 +88,7 @@ void Parser::updateLocationEndFrom(
 			DebugData updatedDebugData = *_debugData;
 			updatedDebugData.nativeLocation.end = _location.end;
 			updatedDebugData.originLocation.end = _location.end;
-			_debugData = make_shared<DebugData const>(std::move(updatedDebugData));
+			_debugData = DebugDataRepository::instance().store(std::move(updatedDebugData));
 			break;
 		}
 		case UseSourceLocationFrom::LocationOverride:
@@ -98,7 +98,7 @@ void Parser::updateLocationEndFrom(
 		{
 			DebugData updatedDebugData = *_debugData;
 			updatedDebugData.nativeLocation.end = _location.end;
-			_debugData = make_shared<DebugData const>(std::move(updatedDebugData));
+			_debugData = DebugDataRepository::instance().store(std::move(updatedDebugData));
 			break;
 		}
 	}
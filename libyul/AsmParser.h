@@ -118,10 +118,10 @@ protected:
 	);
 
 	/// Creates a DebugData object with the correct source location set.
-	std::shared_ptr<DebugData const> createDebugData() const;
+	DebugDataHandle createDebugData() const;
 
 	void updateLocationEndFrom(
-		std::shared_ptr<DebugData const>& _debugData,
+		DebugDataHandle& _debugData,
 		langutil::SourceLocation const& _location
 	) const;
 
@@ -306,7 +306,7 @@ string AsmPrinter::formatSourceLocation(
 	return sourceLocation + (solidityCodeSnippet.empty() ? "" : "  ") + solidityCodeSnippet;
 }
 
-string AsmPrinter::formatDebugData(shared_ptr<DebugData const> const& _debugData, bool _statement)
+string AsmPrinter::formatDebugData(DebugDataHandle const& _debugData, bool _statement)
 {
 	if (!_debugData || m_debugInfoSelection.none())
 		return "";
@@ -0,0 +1,259 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/ObjectOptimizationCache.h>
+
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTCopier.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libsolutil/Keccak256.h>
+
+#include <limits>
+#include <typeinfo>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+namespace
+{
+
+/**
+ * Writes everything about a Yul AST that ends up in the optimized code into a compact
+ * binary form: the structure, all identifiers and literals, and the debug data except
+ * for the locations in the Yul code itself.
+ * Unlike BlockHasher, it does not identify code that only differs in the names of its
+ * variables, since these names are visible in the optimized code.
+ */
+class CodeSerializer
+{
+public:
+	explicit CodeSerializer(bytes& _out): m_out(_out) {}
+
+	void operator()(Literal const& _literal)
+	{
+		node(1, _literal.debugData);
+		m_out.push_back(static_cast<uint8_t>(_literal.kind));
+		name(_literal.value);
+		name(_literal.type);
+	}
+	void operator()(Identifier const& _identifier)
+	{
+		node(2, _identifier.debugData);
+		name(_identifier.name);
+	}
+	void operator()(FunctionCall const& _call)
+	{
+		node(3, _call.debugData);
+		(*this)(_call.functionName);
+		expressions(_call.arguments);
+	}
+	void operator()(ExpressionStatement const& _statement)
+	{
+		node(4, _statement.debugData);
+		std::visit(*this, _statement.expression);
+	}
+	void operator()(Assignment const& _assignment)
+	{
+		node(5, _assignment.debugData);
+		number(_assignment.variableNames.size());
+		for (Identifier const& variable: _assignment.variableNames)
+			(*this)(variable);
+		optionalExpression(_assignment.value.get());
+	}
+	void operator()(VariableDeclaration const& _declaration)
+	{
+		node(6, _declaration.debugData);
+		typedNames(_declaration.variables);
+		optionalExpression(_declaration.value.get());
+	}
+	void operator()(FunctionDefinition const& _function)
+	{
+		node(7, _function.debugData);
+		name(_function.name);
+		typedNames(_function.parameters);
+		typedNames(_function.returnVariables);
+		(*this)(_function.body);
+	}
+	void operator()(If const& _if)
+	{
+		node(8, _if.debugData);
+		std::visit(*this, *_if.condition);
+		(*this)(_if.body);
+	}
+	void operator()(Switch const& _switch)
+	{
+		node(9, _switch.debugData);
+		std::visit(*this, *_switch.expression);
+		number(_switch.cases.size());
+		for (Case const& switchCase: _switch.cases)
+		{
+			node(10, switchCase.debugData);
+			if (switchCase.value)
+				(*this)(*switchCase.value);
+			else
+				m_out.push_back(0);
+			(*this)(switchCase.body);
+		}
+	}
+	void operator()(ForLoop const& _loop)
+	{
+		node(11, _loop.debugData);
+		(*this)(_loop.pre);
+		std::visit(*this, *_loop.condition);
+		(*this)(_loop.post);
+		(*this)(_loop.body);
+	}
+	void operator()(Break const& _break) { node(12, _break.debugData); }
+	void operator()(Continue const& _continue) { node(13, _continue.debugData); }
+	void operator()(Leave const& _leave) { node(14, _leave.debugData); }
+	void operator()(Block const& _block)
+	{
+		node(15, _block.debugData);
+		number(_block.statements.size());
+		for (Statement const& statement: _block.statements)
+			std::visit(*this, statement);
+	}
+
+private:
+	void node(uint8_t _kind, DebugDataHandle const& _debugData)
+	{
+		m_out.push_back(_kind);
+		if (!_debugData)
+		{
+			m_out.push_back(0);
+			return;
+		}
+		m_out.push_back(1);
+		// The location in the Yul code only appears in error messages, but would keep
+		// the same object embedded at different places of the Yul source from matching.
+		location(_debugData->originLocation);
+		if (_debugData->astID)
+		{
+			m_out.push_back(1);
+			number(static_cast<uint64_t>(*_debugData->astID));
+		}
+		else
+			m_out.push_back(0);
+	}
+	void location(SourceLocation const& _location)
+	{
+		number(static_cast<uint64_t>(_location.start));
+		number(static_cast<uint64_t>(_location.end));
+		if (_location.sourceName)
+			text(*_location.sourceName);
+		else
+			number(numeric_limits<uint64_t>::max());
+	}
+	void expressions(vector<Expression> const& _expressions)
+	{
+		number(_expressions.size());
+		for (Expression const& expression: _expressions)
+			std::visit(*this, expression);
+	}
+	void optionalExpression(Expression const* _expression)
+	{
+		if (_expression)
+		{
+			m_out.push_back(1);
+			std::visit(*this, *_expression);
+		}
+		else
+			m_out.push_back(0);
+	}
+	void typedNames(TypedNameList const& _names)
+	{
+		number(_names.size());
+		for (TypedName const& typedName: _names)
+		{
+			node(16, typedName.debugData);
+			name(typedName.name);
+			name(typedName.type);
+		}
+	}
+	void name(YulString _name) { text(_name.str()); }
+	void text(string const& _text)
+	{
+		number(_text.size());
+		m_out.insert(m_out.end(), _text.begin(), _text.end());
+	}
+	void number(uint64_t _value)
+	{
+		for (size_t i = 0; i < 8; ++i)
+			m_out.push_back(static_cast<uint8_t>(_value >> (8 * i)));
+	}
+
+	bytes& m_out;
+};
+
+}
+
+util::h256 ObjectOptimizationCache::cacheKey(
+	Object const& _object,
+	Dialect const& _dialect,
+	bool _isCreation,
+	frontend::OptimiserSettings const& _settings
+)
+{
+	yulAssert(_object.code, "");
+
+	bytes code;
+	CodeSerializer{code}(*_object.code);
+	string key = keccak256(code).hex();
+
+	key += "\n" + _object.name.str();
+	// Data names are accessible from the code and influence its analysis.
+	for (YulString const& dataName: _object.qualifiedDataNames())
+		key += "\n" + dataName.str();
+
+	key += "\n" + _settings.yulOptimiserSteps + "\n" + _settings.yulOptimiserCleanupSteps;
+	key += "\n" + to_string(_settings.optimizeStackAllocation);
+	key += "\n" + to_string(_settings.expectedExecutionsPerDeployment);
+	key += "\n" + to_string(_isCreation);
+	// Identifies the dialect by its parameters rather than by the instance, so that
+	// keys stay valid if a dialect is created again.
+	key += "\n"s + typeid(_dialect).name();
+	if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect))
+		key += "\n" + evmDialect->evmVersion().name() + "\n" + to_string(evmDialect->providesObjectAccess());
+
+	return util::keccak256(key);
+}
+
+bool ObjectOptimizationCache::restore(util::h256 const& _key, Object& _object) const
+{
+	auto it = m_optimizedCode.find(_key);
+	if (it == m_optimizedCode.end())
+		return false;
+
+	_object.code = make_shared<Block>(ASTCopier{}.translate(*it->second));
+	return true;
+}
+
+void ObjectOptimizationCache::store(util::h256 const& _key, Object const& _object)
+{
+	yulAssert(_object.code, "");
+	m_optimizedCode[_key] = make_shared<Block const>(ASTCopier{}.translate(*_object.code));
+}
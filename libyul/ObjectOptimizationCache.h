@@ -0,0 +1,78 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of optimized Yul objects, shared between the stacks of a single compilation.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace solidity::frontend
+{
+struct OptimiserSettings;
+}
+
+namespace solidity::yul
+{
+struct Dialect;
+struct Object;
+
+/**
+ * Stores the optimized code of Yul objects, keyed by their code before optimization
+ * and by everything else that influences the result of the optimizer.
+ *
+ * Objects are optimized independently of the objects they are embedded in, so the result
+ * can be reused whenever the same object appears again, e.g. the code of a contract that is
+ * compiled on its own and also embedded into all contracts that create it.
+ *
+ * Only the code of the object itself is cached, sub-objects have entries of their own.
+ */
+class ObjectOptimizationCache
+{
+public:
+	/// @returns the key under which the result of optimizing @a _object is stored.
+	/// Has to be computed before the object is optimized.
+	static util::h256 cacheKey(
+		Object const& _object,
+		Dialect const& _dialect,
+		bool _isCreation,
+		frontend::OptimiserSettings const& _settings
+	);
+
+	/// Replaces the code of @a _object by a copy of the optimized code stored under @a _key.
+	/// Does not update the analysis info of the object.
+	/// @returns false if there is no such entry and the object was left unchanged.
+	bool restore(util::h256 const& _key, Object& _object) const;
+
+	/// Stores a copy of the (already optimized) code of @a _object under @a _key.
+	void store(util::h256 const& _key, Object const& _object);
+
+	size_t size() const { return m_optimizedCode.size(); }
+
+private:
+	std::map<util::h256, std::shared_ptr<Block const>> m_optimizedCode;
+};
+
+}
@@ -91,8 +91,15 @@ u256 solidity::yul::valueOfNumberLiteral(Literal const& _literal)
 {
 	yulAssert(_literal.kind == LiteralKind::Number, "Expected number literal!");
 
-	static map<YulString, u256> numberCache;
-	static YulStringRepository::ResetCallback callback{[&] { numberCache.clear(); }};
+	// Each thread has its own cache, so that it can be used without locking.
+	// It refers to the strings of the repository and is outdated once they are freed.
+	thread_local map<YulString, u256> numberCache;
+	thread_local size_t numberCacheGeneration = 0;
+	if (size_t const generation = YulStringRepository::generation(); generation != numberCacheGeneration)
+	{
+		numberCache.clear();
+		numberCacheGeneration = generation;
+	}
 
 	auto&& [it, isNew] = numberCache.try_emplace(_literal.value, 0);
 	if (isNew)
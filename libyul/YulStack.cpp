@@ -33,6 +33,7 @@
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/wasm/WasmObjectCompiler.h>
 #include <libyul/backends/wasm/EVMToEwasmTranslator.h>
+#include <libyul/ObjectOptimizationCache.h>
 #include <libyul/ObjectParser.h>
 #include <libyul/optimiser/Suite.h>
 
@@ -179,6 +180,15 @@ void YulStack::optimize(Object& _object, bool _isCreation)
 		}
 
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+	optional<util::h256> cacheKey;
+	if (m_optimizationCache)
+	{
+		cacheKey = ObjectOptimizationCache::cacheKey(_object, dialect, _isCreation, m_optimiserSettings);
+		// The analysis info is outdated now, but it is recomputed for all objects after optimization.
+		if (m_optimizationCache->restore(*cacheKey, _object))
+			return;
+	}
+
 	unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
@@ -190,8 +200,12 @@ void YulStack::optimize(Object& _object, bool _isCreation)
 		m_optimiserSettings.yulOptimiserSteps,
 		m_optimiserSettings.yulOptimiserCleanupSteps,
 		_isCreation ? nullopt : make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
+		{},
+		m_optimiserSettings.profile.get()
 	);
+
+	if (cacheKey)
+		m_optimizationCache->store(*cacheKey, _object);
 }
 
 MachineAssemblyObject YulStack::assemble(Machine _machine) const
@@ -264,7 +278,7 @@ YulStack::assembleEVMWithDeployed(optional<string_view> _deployName) const
 	yulAssert(m_parserResult->code, "");
 	yulAssert(m_parserResult->analysisInfo, "");
 
-	evmasm::Assembly assembly(m_evmVersion, true, {});
+	evmasm::Assembly assembly(m_evmVersion, true, m_parserResult->name.str());
 	EthAssemblyAdapter adapter(assembly);
 	compileEVM(adapter, m_optimiserSettings.optimizeStackAllocation);
 
@@ -50,6 +50,7 @@ class Scanner;
 namespace solidity::yul
 {
 class AbstractAssembly;
+class ObjectOptimizationCache;
 
 
 struct MachineAssemblyObject
@@ -84,13 +85,15 @@ public:
 		std::optional<uint8_t> _eofVersion,
 		Language _language,
 		solidity::frontend::OptimiserSettings _optimiserSettings,
-		langutil::DebugInfoSelection const& _debugInfoSelection
+		langutil::DebugInfoSelection const& _debugInfoSelection,
+		std::shared_ptr<ObjectOptimizationCache> _optimizationCache = nullptr
 	):
 		m_language(_language),
 		m_evmVersion(_evmVersion),
 		m_eofVersion(_eofVersion),
 		m_optimiserSettings(std::move(_optimiserSettings)),
 		m_debugInfoSelection(_debugInfoSelection),
+		m_optimizationCache(std::move(_optimizationCache)),
 		m_errorReporter(m_errors)
 	{}
 
@@ -103,6 +106,8 @@ public:
 
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
+	/// If an optimization cache was provided, objects already optimized by another stack
+	/// sharing the cache are taken from there instead of being optimized again.
 	void optimize();
 
 	/// Translate the source to a different language / dialect.
@@ -152,6 +157,7 @@ private:
 	std::optional<uint8_t> m_eofVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
 	langutil::DebugInfoSelection m_debugInfoSelection{};
+	std::shared_ptr<ObjectOptimizationCache> m_optimizationCache;
 
 	std::unique_ptr<langutil::CharStream> m_charStream;
 
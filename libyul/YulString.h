@@ -21,12 +21,19 @@
 
 #pragma once
 
+#include <libsolutil/Assertions.h>
+
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <functional>
 
 namespace solidity::yul
@@ -36,6 +43,9 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+/// The repository can be used from multiple threads at the same time, except for reset().
+/// The strings are distributed over independently locked shards by their hash and are never moved,
+/// so that looking up the string of an ID does not require any locking.
 class YulStringRepository
 {
 public:
@@ -51,26 +61,32 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	Handle stringToHandle(std::string_view _string)
 	{
 		if (_string.empty())
 			return { 0, emptyHash() };
 		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
+		size_t const shardIndex = static_cast<size_t>(h >> (64 - shardBits));
+		Shard& shard = m_shards[shardIndex];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		auto range = shard.hashToIndex.equal_range(h);
 		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
+			if (shard.strings[it->second] == _string)
+				return Handle{(it->second << shardBits) | shardIndex, h};
+		size_t index = shard.strings.push_back(_string);
+		shard.hashToIndex.emplace_hint(range.second, std::make_pair(h, index));
 
-		return Handle{id, h};
+		return Handle{(index << shardBits) | shardIndex, h};
+	}
+	std::string const& idToString(size_t _id) const
+	{
+		// The ID was handed out after the string was stored, so it can be read without locking.
+		return m_shards[_id & (shardCount - 1)].strings[_id >> shardBits];
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
-	static std::uint64_t hash(std::string const& v)
+	static std::uint64_t hash(std::string_view v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
+		// FNV hash. The order of YulStrings, and thus the generated code, depends on it.
 		std::uint64_t hash = emptyHash();
 		for (char c: v)
 		{
@@ -89,8 +105,20 @@ public:
 	{
 		for (auto const& cb: resetCallbacks())
 			cb();
-		instance() = YulStringRepository{};
+		YulStringRepository& repository = instance();
+		repository.m_generation++;
+		for (Shard& shard: repository.m_shards)
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			shard.strings.clear();
+			shard.hashToIndex.clear();
+			if (&shard == &repository.m_shards[0])
+				shard.strings.push_back({});
+		}
 	}
+	/// @returns the number of times the repository was reset. Caches that cannot be cleared
+	/// from a reset callback, e.g. thread-local ones, can compare it to detect outdated entries.
+	static size_t generation() { return instance().m_generation; }
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
@@ -100,13 +128,35 @@ public:
 			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
 		}
 	};
+	/// Marks a use of the repository for the lifetime of the object.
+	/// The repository is only reset when a scope starts while no other scope is active,
+	/// so that the strings of an active scope stay valid. This does not make concurrent
+	/// compilations safe: other global state, e.g. the type provider and the dialect
+	/// caches, is not synchronised.
+	class Scope
+	{
+	public:
+		Scope()
+		{
+			YulStringRepository& repository = instance();
+			std::lock_guard<std::mutex> lock(repository.m_scopeMutex);
+			if (repository.m_activeScopes++ == 0)
+				reset();
+		}
+		~Scope()
+		{
+			YulStringRepository& repository = instance();
+			std::lock_guard<std::mutex> lock(repository.m_scopeMutex);
+			repository.m_activeScopes--;
+		}
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+	};
 
 private:
-	YulStringRepository() = default;
+	YulStringRepository() { m_shards[0].strings.push_back({}); }
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
@@ -114,8 +164,56 @@ private:
 		return callbacks;
 	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	/// Append-only sequence of strings stored in fixed-size segments.
+	/// Appending requires external synchronisation, but never moves the stored strings,
+	/// so they can be read concurrently.
+	class Strings
+	{
+	public:
+		size_t push_back(std::string_view _string)
+		{
+			size_t const segment = m_size >> segmentBits;
+			assertThrow(segment < m_segments.size(), util::Exception, "Too many distinct Yul identifiers.");
+			if (!m_segments[segment])
+				m_segments[segment] = std::make_unique<std::string[]>(size_t(1) << segmentBits);
+			m_segments[segment][m_size & ((size_t(1) << segmentBits) - 1)] = _string;
+			return m_size++;
+		}
+		std::string const& operator[](size_t _index) const
+		{
+			return m_segments[_index >> segmentBits][_index & ((size_t(1) << segmentBits) - 1)];
+		}
+		/// Frees all strings, but keeps the first segment allocated.
+		void clear()
+		{
+			for (size_t segment = 1; segment < m_segments.size() && m_segments[segment]; segment++)
+				m_segments[segment].reset();
+			if (m_segments[0])
+				for (size_t i = 0; i < std::min(m_size, size_t(1) << segmentBits); i++)
+					m_segments[0][i] = std::string{};
+			m_size = 0;
+		}
+
+	private:
+		static constexpr size_t segmentBits = 10;
+		std::array<std::unique_ptr<std::string[]>, 8192> m_segments;
+		size_t m_size = 0;
+	};
+
+	struct Shard
+	{
+		Strings strings;
+		std::unordered_multimap<std::uint64_t, size_t> hashToIndex;
+		std::mutex mutex;
+	};
+
+	static constexpr size_t shardBits = 4;
+	static constexpr size_t shardCount = size_t(1) << shardBits;
+	/// Shard zero holds the empty string at index zero, so that it has the ID zero.
+	std::array<Shard, shardCount> m_shards;
+	std::mutex m_scopeMutex;
+	size_t m_activeScopes = 0;
+	std::atomic<size_t> m_generation{0};
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -126,7 +224,9 @@ class YulString
 {
 public:
 	YulString() = default;
-	explicit YulString(std::string const& _s): m_handle(YulStringRepository::instance().stringToHandle(_s)) {}
+	explicit YulString(std::string_view _s): m_handle(YulStringRepository::instance().stringToHandle(_s)) {}
+	explicit YulString(std::string const& _s): YulString(std::string_view(_s)) {}
+	explicit YulString(char const* _s): YulString(std::string_view(_s)) {}
 	YulString(YulString const&) = default;
 	YulString(YulString&&) = default;
 	YulString& operator=(YulString const&) = default;
@@ -164,7 +264,7 @@ private:
 
 inline YulString operator "" _yulstring(char const* _string, std::size_t _size)
 {
-	return YulString(std::string(_string, _size));
+	return YulString(std::string_view(_string, _size));
 }
 
 }
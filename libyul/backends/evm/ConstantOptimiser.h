@@ -25,7 +25,7 @@
 #include <libyul/YulString.h>
 #include <libyul/Dialect.h>
 #include <libyul/backends/evm/EVMDialect.h>
-#include <libyul/ASTForward.h>
+#include <libyul/AST.h>
 
 #include <liblangutil/SourceLocation.h>
 
@@ -74,7 +74,7 @@ public:
 	RepresentationFinder(
 		EVMDialect const& _dialect,
 		GasMeter const& _meter,
-		std::shared_ptr<DebugData const> _debugData,
+		DebugDataHandle _debugData,
 		std::map<u256, Representation>& _cache
 	):
 		m_dialect(_dialect),
@@ -100,7 +100,7 @@ private:
 
 	EVMDialect const& m_dialect;
 	GasMeter const& m_meter;
-	std::shared_ptr<DebugData const> m_debugData;
+	DebugDataHandle m_debugData;
 	/// Counter for the complexity of optimization, will stop when it reaches zero.
 	size_t m_maxSteps = 10000;
 	std::map<u256, Representation>& m_cache;
@@ -28,7 +28,10 @@
 #include <liblangutil/EVMVersion.h>
 
 #include <map>
+#include <mutex>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace solidity::yul
 {
@@ -98,9 +101,11 @@ protected:
 
 	bool const m_objectAccess;
 	langutil::EVMVersion const m_evmVersion;
-	std::map<YulString, BuiltinFunctionForEVM> m_functions;
+	std::unordered_map<YulString, BuiltinFunctionForEVM> m_functions;
 	std::map<std::pair<size_t, size_t>, std::shared_ptr<BuiltinFunctionForEVM const>> mutable m_verbatimFunctions;
-	std::set<YulString> m_reserved;
+	/// Protects m_verbatimFunctions, since dialects are shared between threads.
+	std::mutex mutable m_verbatimFunctionsMutex;
+	std::unordered_set<YulString> m_reserved;
 };
 
 /**
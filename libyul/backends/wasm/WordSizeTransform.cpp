@@ -280,7 +280,7 @@ void WordSizeTransform::rewriteIdentifierList(vector<Identifier>& _ids)
 }
 
 vector<Statement> WordSizeTransform::handleSwitchInternal(
-	shared_ptr<DebugData const> const& _debugData,
+	DebugDataHandle const& _debugData,
 	vector<YulString> const& _splitExpressions,
 	vector<Case> _cases,
 	YulString _runDefaultFlag,
@@ -134,6 +134,38 @@ public:
 	void operator()(FunctionCall const& _funCall) override;
 };
 
+/**
+ * Computes a hash of a block including all nested blocks and function definitions that is
+ * likely different for blocks that differ in anything but the formatting of number literals.
+ * Like the ExpressionHasher, it takes the names of all identifiers into account.
+ * Can be used to cheaply detect whether a transformation changed code without keeping a copy of it.
+ */
+class CodeHasher: public ASTWalker, public HasherBase
+{
+public:
+	static uint64_t run(Block const& _block);
+
+	using ASTWalker::operator();
+
+	void operator()(Literal const&) override;
+	void operator()(Identifier const&) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const& _funDef) override;
+	void operator()(ForLoop const& _loop) override;
+	void operator()(Break const&) override;
+	void operator()(Continue const&) override;
+	void operator()(Leave const&) override;
+	void operator()(Block const& _block) override;
+
+private:
+	void hashTypedNames(std::vector<TypedName> const& _names);
+};
+
 struct ExpressionHash
 {
 	uint64_t operator()(Expression const& _expression) const
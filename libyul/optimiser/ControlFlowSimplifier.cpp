@@ -38,7 +38,7 @@ namespace
 {
 
 ExpressionStatement makeDiscardCall(
-	std::shared_ptr<DebugData const> const& _debugData,
+	DebugDataHandle const& _debugData,
 	BuiltinFunction const& _discardFunction,
 	Expression&& _expression
 )
@@ -197,7 +197,7 @@ OptionalStatements ControlFlowSimplifier::reduceSingleCaseSwitch(Switch& _switch
 	yulAssert(_switchStmt.cases.size() == 1, "Expected only one case!");
 
 	auto& switchCase = _switchStmt.cases.front();
-	shared_ptr<DebugData const> debugData = debugDataOf(*_switchStmt.expression);
+	DebugDataHandle debugData = debugDataOf(*_switchStmt.expression);
 	YulString type = m_typeInfo.typeOf(*_switchStmt.expression);
 	if (switchCase.value)
 	{
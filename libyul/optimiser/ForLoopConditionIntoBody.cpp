@@ -39,7 +39,7 @@ void ForLoopConditionIntoBody::operator()(ForLoop& _forLoop)
 		!holds_alternative<Identifier>(*_forLoop.condition)
 	)
 	{
-		shared_ptr<DebugData const> debugData = debugDataOf(*_forLoop.condition);
+		DebugDataHandle debugData = debugDataOf(*_forLoop.condition);
 
 		_forLoop.body.statements.emplace(
 			begin(_forLoop.body.statements),
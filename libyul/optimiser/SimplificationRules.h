@@ -131,7 +131,7 @@ public:
 
 	/// Turns this pattern into an actual expression. Should only be called
 	/// for patterns resulting from an action, i.e. with match groups assigned.
-	Expression toExpression(std::shared_ptr<DebugData const> const& _debugData, langutil::EVMVersion _evmVersion) const;
+	Expression toExpression(DebugDataHandle const& _debugData, langutil::EVMVersion _evmVersion) const;
 
 private:
 	Expression const& matchGroupValue() const;
@@ -55,7 +55,7 @@
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/StackLimitEvader.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
-#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/UnusedAssignEliminator.h>
 #include <libyul/optimiser/UnusedStoreEliminator.h>
 #include <libyul/optimiser/VarNameCleaner.h>
@@ -74,6 +74,7 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/OptimiserProfile.h>
 
 #include <libyul/CompilabilityChecker.h>
 
@@ -81,54 +82,23 @@
 #include <range/v3/action/remove.hpp>
 
 #include <limits>
+#include <map>
+#include <optional>
 #include <tuple>
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-#include <chrono>
-#include <fmt/format.h>
-#endif
-
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
-#ifdef PROFILE_OPTIMIZER_STEPS
-using namespace std::chrono;
-#endif
 
 namespace
 {
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-void outputPerformanceMetrics(map<string, int64_t> const& _metrics)
+/// @returns the number of nodes of @a _ast, including the bodies of functions.
+size_t countNodes(Block const& _ast)
 {
-	vector<pair<string, int64_t>> durations(_metrics.begin(), _metrics.end());
-	sort(
-		durations.begin(),
-		durations.end(),
-		[](pair<string, int64_t> const& _lhs, pair<string, int64_t> const& _rhs) -> bool
-		{
-			return _lhs.second < _rhs.second;
-		}
-	);
-
-	int64_t totalDurationInMicroseconds = 0;
-	for (auto&& [step, durationInMicroseconds]: durations)
-		totalDurationInMicroseconds += durationInMicroseconds;
-
-	cerr << "Performance metrics of optimizer steps" << endl;
-	cerr << "======================================" << endl;
-	constexpr double microsecondsInSecond = 1000000;
-	for (auto&& [step, durationInMicroseconds]: durations)
-	{
-		double percentage = 100.0 * static_cast<double>(durationInMicroseconds) / static_cast<double>(totalDurationInMicroseconds);
-		double sec = static_cast<double>(durationInMicroseconds) / microsecondsInSecond;
-		cerr << fmt::format("{:>7.3f}% ({} s): {}", percentage, sec, step) << endl;
-	}
-	double totalDurationInSeconds = static_cast<double>(totalDurationInMicroseconds) / microsecondsInSecond;
-	cerr << "--------------------------------------" << endl;
-	cerr << fmt::format("{:>7}% ({:.3f} s)", 100, totalDurationInSeconds) << endl;
+	static CodeWeights const allOnes{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+	return CodeSize::codeSizeIncludingFunctions(_ast, allOnes);
 }
-#endif
 
 }
 
@@ -141,7 +111,8 @@ void OptimiserSuite::run(
 	string_view _optimisationSequence,
 	string_view _optimisationCleanupSequence,
 	optional<size_t> _expectedExecutionsPerDeployment,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	util::OptimiserProfile* _profile
 )
 {
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
@@ -164,6 +135,24 @@ void OptimiserSuite::run(
 	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
 
 	OptimiserSuite suite(context, Debug::None);
+	suite.m_profile = _profile;
+	if (_profile)
+		// Objects without name only come from the legacy code generator, which uses them for
+		// inline assembly and utility functions.
+		suite.m_profileObjectName =
+			!_object.name.empty() ? _object.name.str() :
+			_expectedExecutionsPerDeployment ? "<runtime>" : "<creation>";
+	auto measure = [&](char const* _step) -> optional<util::OptimiserProfile::Measurement> {
+		if (!_profile)
+			return nullopt;
+		return optional<util::OptimiserProfile::Measurement>(
+			in_place,
+			_profile,
+			suite.m_profileObjectName,
+			_step,
+			[&]() { return countNodes(ast); }
+		);
+	};
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -180,12 +169,15 @@ void OptimiserSuite::run(
 	// We ignore the return value because we will get a much better error
 	// message once we perform code generation.
 	if (!usesOptimizedCodeGenerator)
+	{
+		auto measurement = measure("StackCompressor");
 		StackCompressor::run(
 			_dialect,
 			_object,
 			_optimizeStackAllocation,
 			stackCompressorMaxIterations
 		);
+	}
 
 	// Run the user-supplied clean up sequence
 	suite.runSequence(_optimisationCleanupSequence, ast);
@@ -197,20 +189,32 @@ void OptimiserSuite::run(
 	if (evmDialect)
 	{
 		yulAssert(_meter, "");
-		ConstantOptimiser{*evmDialect, *_meter}(ast);
+		{
+			auto measurement = measure("ConstantOptimiser");
+			ConstantOptimiser{*evmDialect, *_meter}(ast);
+		}
 		if (usesOptimizedCodeGenerator)
 		{
-			StackCompressor::run(
-				_dialect,
-				_object,
-				_optimizeStackAllocation,
-				stackCompressorMaxIterations
-			);
+			{
+				auto measurement = measure("StackCompressor");
+				StackCompressor::run(
+					_dialect,
+					_object,
+					_optimizeStackAllocation,
+					stackCompressorMaxIterations
+				);
+			}
 			if (evmDialect->providesObjectAccess())
+			{
+				auto measurement = measure("StackLimitEvader");
 				StackLimitEvader::run(suite.m_context, _object);
+			}
 		}
 		else if (evmDialect->providesObjectAccess() && _optimizeStackAllocation)
+		{
+			auto measurement = measure("StackLimitEvader");
 			StackLimitEvader::run(suite.m_context, _object);
+		}
 	}
 	else if (dynamic_cast<WasmDialect const*>(&_dialect))
 	{
@@ -224,10 +228,6 @@ void OptimiserSuite::run(
 	NameSimplifier::run(suite.m_context, ast);
 	VarNameCleaner::run(suite.m_context, ast);
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-	outputPerformanceMetrics(suite.m_durationPerStepInMicroseconds);
-#endif
-
 	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
 }
 
@@ -252,43 +252,41 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EqualStoreEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			UnusedAssignEliminator,
-			UnusedStoreEliminator,
-			ReasoningBasedSimplifier,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EqualStoreEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		UnusedAssignEliminator,
+		UnusedStoreEliminator,
+		ReasoningBasedSimplifier,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -487,31 +485,35 @@ void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bo
 
 void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 {
-	unique_ptr<Block> copy;
+	// Changes are detected by comparing hashes, which avoids keeping a copy of the code.
+	optional<uint64_t> codeHash;
 	if (m_debug == Debug::PrintChanges)
-		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+		codeHash = CodeHasher::run(_ast);
 	for (string const& step: _steps)
 	{
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-#ifdef PROFILE_OPTIMIZER_STEPS
-		steady_clock::time_point startTime = steady_clock::now();
-#endif
-		allSteps().at(step)->run(m_context, _ast);
-#ifdef PROFILE_OPTIMIZER_STEPS
-		steady_clock::time_point endTime = steady_clock::now();
-		m_durationPerStepInMicroseconds[step] += duration_cast<microseconds>(endTime - startTime).count();
-#endif
+		{
+			optional<util::OptimiserProfile::Measurement> measurement;
+			if (m_profile)
+				measurement.emplace(
+					m_profile,
+					m_profileObjectName,
+					string(1, stepNameToAbbreviationMap().at(step)),
+					[&]() { return countNodes(_ast); }
+				);
+			allSteps().at(step)->run(m_context, _ast);
+		}
 		if (m_debug == Debug::PrintChanges)
 		{
-			// TODO should add switch to also compare variable names!
-			if (SyntacticallyEqual{}.statementEqual(_ast, *copy))
+			uint64_t newCodeHash = CodeHasher::run(_ast);
+			if (newCodeHash == *codeHash)
 				cout << "== Running " << step << " did not cause changes." << endl;
 			else
 			{
 				cout << "== Running " << step << " changed the AST." << endl;
 				cout << AsmPrinter{}(_ast) << endl;
-				copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+				codeHash = newCodeHash;
 			}
 		}
 	}
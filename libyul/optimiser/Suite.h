@@ -32,6 +32,11 @@
 #include <string_view>
 #include <memory>
 
+namespace solidity::util
+{
+class OptimiserProfile;
+}
+
 namespace solidity::yul
 {
 
@@ -62,6 +67,8 @@ public:
 	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// If @a _profile is given, the time spent in each step and the number of AST nodes
+	/// before and after it are recorded there.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -70,7 +77,8 @@ public:
 		std::string_view _optimisationSequence,
 		std::string_view _optimisationCleanupSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		util::OptimiserProfile* _profile = nullptr
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -87,9 +95,10 @@ public:
 private:
 	OptimiserStepContext& m_context;
 	Debug m_debug;
-#ifdef PROFILE_OPTIMIZER_STEPS
-	std::map<std::string, int64_t> m_durationPerStepInMicroseconds;
-#endif
+	/// Profile that the executed steps are recorded in, if any.
+	util::OptimiserProfile* m_profile = nullptr;
+	/// Name under which the steps are recorded in the profile.
+	std::string m_profileObjectName;
 };
 
 }
@@ -56,6 +56,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/OptimiserProfile.h>
 
 #include <algorithm>
 #include <fstream>
@@ -157,7 +158,8 @@ static bool needsHumanTargetedStdout(CommandLineOptions const& _options)
 		_options.compiler.outputs.natspecDev ||
 		_options.compiler.outputs.opcodes ||
 		_options.compiler.outputs.signatureHashes ||
-		_options.compiler.outputs.storageLayout;
+		_options.compiler.outputs.storageLayout ||
+		_options.optimizer.profile;
 }
 
 static bool coloredOutput(CommandLineOptions const& _options)
@@ -389,6 +391,25 @@ void CommandLineInterface::handleNatspec(bool _natspecDev, string const& _contra
 	}
 }
 
+void CommandLineInterface::handleOptimizerProfile(string const& _contract)
+{
+	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	if (!m_options.optimizer.profile)
+		return;
+
+	Json::Value profile = m_compiler->optimiserProfile(_contract);
+	// Contracts that cannot be deployed are never optimized.
+	if (profile.isNull())
+		return;
+
+	string data = jsonPrint(profile, m_options.formatting.json);
+	if (!m_options.output.dir.empty())
+		createFile(m_compiler->filesystemFriendlyName(_contract) + "_profile.json", data);
+	else
+		sout() << "Optimizer profile:" << endl << data << endl;
+}
+
 void CommandLineInterface::handleGasEstimation(string const& _contract)
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
@@ -652,9 +673,18 @@ void CommandLineInterface::processInput()
 	{
 		solAssert(m_standardJsonInput.has_value());
 
-		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
+		shared_ptr<CompilationCache> cache;
+		if (!m_options.input.cacheDir.empty())
+			cache = m_options.input.cacheSizeLimit.has_value() ?
+				make_shared<CompilationCache>(m_options.input.cacheDir, m_options.input.cacheSizeLimit.value()) :
+				make_shared<CompilationCache>(m_options.input.cacheDir);
+
+		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json, cache);
 		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << endl;
 		m_standardJsonInput.reset();
+		// Reported on stderr, so that the JSON output is the same with and without the cache.
+		if (cache && cache->hits() + cache->misses() > 0)
+			serr() << "Compilation cache: " << cache->hits() << " hit(s), " << cache->misses() << " miss(es)." << endl;
 		break;
 	}
 	case InputMode::LanguageServer:
@@ -715,8 +745,10 @@ void CommandLineInterface::compile()
 
 		m_compiler->enableIRGeneration(m_options.compiler.outputs.ir || m_options.compiler.outputs.irOptimized);
 		m_compiler->enableEwasmGeneration(m_options.compiler.outputs.ewasm);
+		m_compiler->enableOptimiserProfiling(m_options.optimizer.profile);
 		m_compiler->enableEvmBytecodeGeneration(
 			m_options.compiler.estimateGas ||
+			m_options.optimizer.profile ||
 			m_options.compiler.outputs.asm_ ||
 			m_options.compiler.outputs.asmJson ||
 			m_options.compiler.outputs.opcodes ||
@@ -1035,16 +1067,21 @@ void CommandLineInterface::assemble(yul::YulStack::Language _language, yul::YulS
 
 	bool successful = true;
 	map<string, yul::YulStack> yulStacks;
+	map<string, shared_ptr<util::OptimiserProfile>> optimiserProfiles;
 	for (auto const& src: m_fileReader.sourceUnits())
 	{
 		// --no-optimize-yul option is not accepted in assembly mode.
 		solAssert(!m_options.optimizer.noOptimizeYul);
 
+		OptimiserSettings optimiserSettings = m_options.optimiserSettings();
+		if (m_options.optimizer.profile)
+			optimiserSettings.profile = optimiserProfiles[src.first] = make_shared<util::OptimiserProfile>();
+
 		auto& stack = yulStacks[src.first] = yul::YulStack(
 			m_options.output.evmVersion,
 			m_options.output.eofVersion,
 			_language,
-			m_options.optimiserSettings(),
+			optimiserSettings,
 			m_options.output.debugInfoSelection.has_value() ?
 				m_options.output.debugInfoSelection.value() :
 				DebugInfoSelection::Default()
@@ -1131,6 +1168,12 @@ void CommandLineInterface::assemble(yul::YulStack::Language _language, yul::YulS
 			else
 				serr() << "No text representation found." << endl;
 		}
+
+		if (m_options.optimizer.profile)
+		{
+			sout() << endl << "Optimizer profile:" << endl;
+			sout() << jsonPrint(optimiserProfiles.at(src.first)->toJson(), m_options.formatting.json) << endl;
+		}
 	}
 }
 
@@ -1186,6 +1229,7 @@ void CommandLineInterface::outputCompilationResults()
 		handleStorageLayout(contract);
 		handleNatspec(true, contract);
 		handleNatspec(false, contract);
+		handleOptimizerProfile(contract);
 	} // end of contracts iteration
 
 	if (!m_hasOutput)
@@ -42,6 +42,8 @@ static string const g_strAllowPaths = "allow-paths";
 static string const g_strBasePath = "base-path";
 static string const g_strIncludePath = "include-path";
 static string const g_strAssemble = "assemble";
+static string const g_strCacheDir = "cache-dir";
+static string const g_strCacheSizeLimit = "cache-size-limit";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strErrorRecovery = "error-recovery";
 static string const g_strEVM = "evm";
@@ -66,10 +68,13 @@ static string const g_strMachine = "machine";
 static string const g_strNoCBORMetadata = "no-cbor-metadata";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerCacheDir = "model-checker-cache-dir";
 static string const g_strModelCheckerContracts = "model-checker-contracts";
 static string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static string const g_strModelCheckerEngine = "model-checker-engine";
 static string const g_strModelCheckerInvariants = "model-checker-invariants";
+static string const g_strModelCheckerJobs = "model-checker-jobs";
+static string const g_strModelCheckerRaceSolvers = "model-checker-race-solvers";
 static string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
 static string const g_strModelCheckerSolvers = "model-checker-solvers";
 static string const g_strModelCheckerTargets = "model-checker-targets";
@@ -77,11 +82,14 @@ static string const g_strModelCheckerTimeout = "model-checker-timeout";
 static string const g_strNone = "none";
 static string const g_strNoOptimizeYul = "no-optimize-yul";
 static string const g_strOptimize = "optimize";
+static string const g_strOptimizeJobs = "optimize-jobs";
+static string const g_strOptimizeMaxIterations = "optimize-max-iterations";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strYulOptimizations = "yul-optimizations";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
+static string const g_strProfileOptimizer = "profile-optimizer";
 static string const g_strRevertStrings = "revert-strings";
 static string const g_strStopAfter = "stop-after";
 static string const g_strParsing = "parsing";
@@ -225,6 +233,8 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		input.allowedDirectories == _other.input.allowedDirectories &&
 		input.ignoreMissingFiles == _other.input.ignoreMissingFiles &&
 		input.errorRecovery == _other.input.errorRecovery &&
+		input.cacheDir == _other.input.cacheDir &&
+		input.cacheSizeLimit == _other.input.cacheSizeLimit &&
 		output.dir == _other.output.dir &&
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
@@ -248,8 +258,11 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		metadata.literalSources == _other.metadata.literalSources &&
 		optimizer.enabled == _other.optimizer.enabled &&
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
+		optimizer.maxIterations == _other.optimizer.maxIterations &&
 		optimizer.noOptimizeYul == _other.optimizer.noOptimizeYul &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.profile == _other.optimizer.profile &&
+		optimizer.jobs == _other.optimizer.jobs &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
 		modelChecker.settings == _other.modelChecker.settings;
 }
@@ -269,6 +282,11 @@ OptimiserSettings CommandLineOptions::optimiserSettings() const
 	if (optimizer.expectedExecutionsPerDeployment.has_value())
 		settings.expectedExecutionsPerDeployment = optimizer.expectedExecutionsPerDeployment.value();
 
+	if (optimizer.maxIterations.has_value())
+		settings.maxIterations = optimizer.maxIterations.value();
+
+	settings.jobs = optimizer.jobs;
+
 	if (optimizer.yulSteps.has_value())
 	{
 		string const fullSequence = optimizer.yulSteps.value();
@@ -572,6 +590,19 @@ General Information)").c_str(),
 			g_strErrorRecovery.c_str(),
 			"Enables additional parser error recovery."
 		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			("Store the output of Standard JSON compilations in the given directory and reuse it "
+			"as long as the input and the imported files stay the same. "
+			"Only available together with --" + g_strStandardJSON + ".").c_str()
+		)
+		(
+			g_strCacheSizeLimit.c_str(),
+			po::value<uint64_t>()->value_name("bytes"),
+			("Maximum total size of the entries in the directory given by --" + g_strCacheDir + ". "
+			"Least recently used entries are removed once it is exceeded. The default is 1 GiB.").c_str()
+		)
 	;
 	desc.add(inputOptions);
 
@@ -809,11 +840,35 @@ General Information)").c_str(),
 			po::value<string>()->value_name("steps"),
 			"Forces yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strOptimizeMaxIterations.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			("Maximum number of times the EVM assembly optimizer repeats its passes on each assembly. "
+			"The default is " + to_string(OptimiserSettings{}.maxIterations) + ". "
+			"A warning is issued if the code was still changing in the last iteration.").c_str()
+		)
+		(
+			g_strOptimizeJobs.c_str(),
+			po::value<unsigned>()->value_name("count"),
+			"Number of threads used to optimize independent parts of the bytecode concurrently, "
+			"e.g. the code of contracts created via \"new\". The generated code does not depend on this number."
+		)
+		(
+			g_strProfileOptimizer.c_str(),
+			"Output the time spent in each optimizer step together with the code size before and after it, "
+			"per contract and object, as JSON."
+		)
 	;
 	desc.add(optimizerOptions);
 
 	po::options_description smtCheckerOptions("Model Checker Options");
 	smtCheckerOptions.add_options()
+		(
+			g_strModelCheckerCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the answers of the solvers in the given directory and reuse them for identical queries "
+			"in later runs. Only definitive answers are stored. The directory is never cleaned up automatically."
+		)
 		(
 			g_strModelCheckerContracts.c_str(),
 			po::value<string>()->value_name("default,<source>:<contract>")->default_value("default"),
@@ -838,6 +893,16 @@ General Information)").c_str(),
 			" Multiple types of invariants can be selected at the same time, separated by a comma and no spaces."
 			" By default no invariants are reported."
 		)
+		(
+			g_strModelCheckerJobs.c_str(),
+			po::value<unsigned>()->value_name("count"),
+			"Number of threads used to check independent verification targets concurrently. "
+			"The reported results do not depend on this number."
+		)
+		(
+			g_strModelCheckerRaceSolvers.c_str(),
+			"Query the selected solvers concurrently and take the first answer instead of asking them one after another."
+		)
 		(
 			g_strModelCheckerShowUnproved.c_str(),
 			"Show all unproved targets separately."
@@ -940,18 +1005,23 @@ void CommandLineParser::processArgs()
 
 	map<string, set<InputMode>> validOptionInputModeCombinations = {
 		// TODO: This should eventually contain all options.
+		{g_strCacheDir, {InputMode::StandardJson}},
+		{g_strCacheSizeLimit, {InputMode::StandardJson}},
 		{g_strErrorRecovery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerRaceSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnproved, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerDivModNoSlacks, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerEngine, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerInvariants, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTimeout, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}}
 	};
@@ -1005,7 +1075,7 @@ void CommandLineParser::processArgs()
 				"Option --" + g_strOptimizeRuns + " is only valid in compiler and assembler modes."
 			);
 
-		for (string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations})
+		for (string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations, g_strOptimizeMaxIterations, g_strOptimizeJobs, g_strProfileOptimizer})
 			if (m_args.count(option) > 0)
 				solThrow(
 					CommandLineValidationError,
@@ -1110,6 +1180,19 @@ void CommandLineParser::processArgs()
 
 	parseInputPathsAndRemappings();
 
+	if (m_args.count(g_strCacheDir))
+	{
+		m_options.input.cacheDir = m_args[g_strCacheDir].as<string>();
+		if (m_options.input.cacheDir.empty())
+			solThrow(CommandLineValidationError, "Empty values are not allowed in --" + g_strCacheDir + ".");
+	}
+	if (m_args.count(g_strCacheSizeLimit))
+	{
+		if (m_options.input.cacheDir.empty())
+			solThrow(CommandLineValidationError, "--" + g_strCacheSizeLimit + " requires --" + g_strCacheDir + ".");
+		m_options.input.cacheSizeLimit = m_args[g_strCacheSizeLimit].as<uint64_t>();
+	}
+
 	if (m_options.input.mode == InputMode::StandardJson)
 		return;
 
@@ -1140,8 +1223,21 @@ void CommandLineParser::processArgs()
 
 	m_options.optimizer.enabled = (m_args.count(g_strOptimize) > 0);
 	m_options.optimizer.noOptimizeYul = (m_args.count(g_strNoOptimizeYul) > 0);
+	m_options.optimizer.profile = (m_args.count(g_strProfileOptimizer) > 0);
 	if (!m_args[g_strOptimizeRuns].defaulted())
 		m_options.optimizer.expectedExecutionsPerDeployment = m_args.at(g_strOptimizeRuns).as<unsigned>();
+	if (m_args.count(g_strOptimizeMaxIterations))
+	{
+		m_options.optimizer.maxIterations = m_args[g_strOptimizeMaxIterations].as<unsigned>();
+		if (*m_options.optimizer.maxIterations == 0)
+			solThrow(CommandLineValidationError, "--" + g_strOptimizeMaxIterations + " must be at least 1.");
+	}
+	if (m_args.count(g_strOptimizeJobs))
+	{
+		m_options.optimizer.jobs = m_args[g_strOptimizeJobs].as<unsigned>();
+		if (m_options.optimizer.jobs == 0)
+			solThrow(CommandLineValidationError, "--" + g_strOptimizeJobs + " must be at least 1.");
+	}
 
 	if (m_args.count(g_strYulOptimizations))
 	{
@@ -1268,6 +1364,13 @@ void CommandLineParser::processArgs()
 		m_options.metadata.format = CompilerStack::MetadataFormat::NoMetadata;
 	}
 
+	if (m_args.count(g_strModelCheckerCacheDir))
+	{
+		m_options.modelChecker.settings.cacheDir = m_args[g_strModelCheckerCacheDir].as<string>();
+		if (m_options.modelChecker.settings.cacheDir.empty())
+			solThrow(CommandLineValidationError, "Empty values are not allowed in --" + g_strModelCheckerCacheDir + ".");
+	}
+
 	if (m_args.count(g_strModelCheckerContracts))
 	{
 		string contractsStr = m_args[g_strModelCheckerContracts].as<string>();
@@ -1298,6 +1401,16 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.invariants = *invs;
 	}
 
+	if (m_args.count(g_strModelCheckerJobs))
+	{
+		m_options.modelChecker.settings.jobs = m_args[g_strModelCheckerJobs].as<unsigned>();
+		if (m_options.modelChecker.settings.jobs == 0)
+			solThrow(CommandLineValidationError, "--" + g_strModelCheckerJobs + " must be at least 1.");
+	}
+
+	if (m_args.count(g_strModelCheckerRaceSolvers))
+		m_options.modelChecker.settings.raceSolvers = true;
+
 	if (m_args.count(g_strModelCheckerShowUnproved))
 		m_options.modelChecker.settings.showUnproved = true;
 
@@ -1324,10 +1437,13 @@ void CommandLineParser::processArgs()
 
 	m_options.metadata.literalSources = (m_args.count(g_strMetadataLiteral) > 0);
 	m_options.modelChecker.initialize =
+		m_args.count(g_strModelCheckerCacheDir) ||
 		m_args.count(g_strModelCheckerContracts) ||
 		m_args.count(g_strModelCheckerDivModNoSlacks) ||
 		m_args.count(g_strModelCheckerEngine) ||
 		m_args.count(g_strModelCheckerInvariants) ||
+		m_args.count(g_strModelCheckerJobs) ||
+		m_args.count(g_strModelCheckerRaceSolvers) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
 		m_args.count(g_strModelCheckerSolvers) ||
 		m_args.count(g_strModelCheckerTargets) ||
@@ -175,6 +175,8 @@ struct CommandLineOptions
 		FileReader::FileSystemPathSet allowedDirectories;
 		bool ignoreMissingFiles = false;
 		bool errorRecovery = false;
+		boost::filesystem::path cacheDir;
+		std::optional<uint64_t> cacheSizeLimit;
 	} input;
 
 	struct
@@ -225,8 +227,11 @@ struct CommandLineOptions
 	{
 		bool enabled = false;
 		std::optional<unsigned> expectedExecutionsPerDeployment;
+		std::optional<unsigned> maxIterations;
 		bool noOptimizeYul = false;
 		std::optional<std::string> yulSteps;
+		bool profile = false;
+		unsigned jobs = 1;
 	} optimizer;
 
 	struct
@@ -103,10 +103,12 @@ namespace
 			return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
 		});
 
+		auto expressionClasses = make_shared<ExpressionClasses>();
 		auto iter = _input.begin();
 		while (iter != _input.end())
 		{
-			KnownState emptyState;
+			expressionClasses->clear();
+			KnownState emptyState{expressionClasses};
 			CommonSubexpressionEliminator eliminator{emptyState};
 			auto orig = iter;
 			iter = eliminator.feedItems(iter, _input.end(), usesMSize);
@@ -1044,9 +1046,54 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 		Instruction::POP
 	};
 	PeepholeOptimiser peepOpt(items);
-	for (size_t i = 0; i < 3; i++)
-		BOOST_CHECK(peepOpt.optimise());
+	// Takes three rounds: LT POP -> POP POP, CALLDATASIZE POP -> (nothing), PUSH POP -> (nothing)
+	BOOST_CHECK(peepOpt.optimise());
 	BOOST_CHECK(items.empty());
+	BOOST_CHECK(!peepOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(peephole_revert_round_without_improvement)
+{
+	// Replacing ADDMOD POP by three POPs makes the code larger, so the round is reverted.
+	AssemblyItems items{
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::ADDMOD,
+		Instruction::POP
+	};
+	AssemblyItems expectation = items;
+	PeepholeOptimiser peepOpt(items);
+	BOOST_CHECK(!peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(peephole_revisit_changed_windows)
+{
+	// The double swap is only revealed after the push/pop pair between the swaps was removed in the first round.
+	AssemblyItems items{
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::SWAP1,
+		u256(1),
+		Instruction::POP,
+		Instruction::SWAP1,
+		Instruction::SSTORE
+	};
+	AssemblyItems expectation{
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::SSTORE
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
 }
 
 BOOST_AUTO_TEST_CASE(peephole_commutative_swap1)
@@ -1309,6 +1356,113 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(optimiser_iteration_budget)
+{
+	Assembly::OptimiserSettings settings;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	for (size_t maxIterations: vector<size_t>{1, 2})
+	{
+		settings.maxIterations = maxIterations;
+		Assembly assembly{settings.evmVersion, false, {}};
+		auto tag = assembly.newTag();
+		assembly.append(tag.pushTag());
+		assembly.append(Instruction::JUMP);
+		assembly.append(tag);
+		assembly.append(u256(1));
+		assembly.append(u256(2));
+		assembly.append(Instruction::SSTORE);
+
+		assembly.optimise(settings);
+
+		// The jump to the next item is removed in the first iteration,
+		// but the tag that is not used anymore only in the second one.
+		AssemblyItems expectation{u256(1), u256(2), Instruction::SSTORE};
+		if (maxIterations == 1)
+			expectation.insert(expectation.begin(), tag);
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			assembly.items().begin(), assembly.items().end(),
+			expectation.begin(), expectation.end()
+		);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(jumpdest_removal_multiple_subassemblies)
+{
+	// This tests that sibling sub-assemblies are optimised independently
+	// of each other, while a sub-assembly shared between siblings is still
+	// optimised with the tags referenced from the first of them.
+
+	Assembly::OptimiserSettings settings;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.jobs = 4;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	AssemblyPointer shared = make_shared<Assembly>(settings.evmVersion, false, string{});
+	auto sharedTag1 = shared->newTag();
+	shared->append(sharedTag1); // Only referenced from the first user
+	shared->append(u256(1));
+	auto sharedTag2 = shared->newTag();
+	shared->append(sharedTag2); // This will be removed
+	shared->append(u256(2));
+
+	AssemblyPointer firstUser = make_shared<Assembly>(settings.evmVersion, false, string{});
+	firstUser->append(u256(0xa0));
+	size_t sharedId = static_cast<size_t>(firstUser->appendSubroutine(shared).data());
+	firstUser->append(sharedTag1.toSubAssemblyTag(sharedId));
+	AssemblyPointer secondUser = make_shared<Assembly>(settings.evmVersion, false, string{});
+	secondUser->append(u256(0xa1));
+	secondUser->appendSubroutine(shared);
+
+	Assembly main{settings.evmVersion, true, {}};
+	vector<AssemblyPointer> subs;
+	for (size_t i = 0; i < 8; ++i)
+	{
+		AssemblyPointer sub = make_shared<Assembly>(settings.evmVersion, false, string{});
+		sub->append(u256(i));
+		sub->append(sub->newTag()); // This will be removed
+		sub->append(u256(0x100 + i));
+		if (i == 0)
+		{
+			sub->appendSubroutine(firstUser);
+			sub->appendSubroutine(secondUser);
+		}
+		main.appendSubroutine(sub);
+		subs.push_back(sub);
+	}
+
+	main.optimise(settings);
+
+	for (size_t i = 0; i < subs.size(); ++i)
+	{
+		AssemblyItems expectation{u256(i), u256(0x100 + i)};
+		if (i == 0)
+			expectation += AssemblyItems{AssemblyItem(PushSubSize, 0), AssemblyItem(PushSubSize, 1)};
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			subs[i]->items().begin(), subs[i]->items().end(),
+			expectation.begin(), expectation.end()
+		);
+	}
+
+	AssemblyItems expectationFirstUser{
+		u256(0xa0), AssemblyItem(PushSubSize, 0), sharedTag1.toSubAssemblyTag(sharedId).pushTag()
+	};
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		firstUser->items().begin(), firstUser->items().end(),
+		expectationFirstUser.begin(), expectationFirstUser.end()
+	);
+
+	AssemblyItems expectationShared{sharedTag1.tag(), u256(1), u256(2)};
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		shared->items().begin(), shared->items().end(),
+		expectationShared.begin(), expectationShared.end()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -1428,7 +1582,7 @@ BOOST_AUTO_TEST_CASE(verbatim_knownstate)
 			Instruction::DUP3,
 			Instruction::DUP4
 		});
-	map<int, unsigned> const& stackElements = state.stackElements();
+	auto const& stackElements = state.stackElements();
 
 	BOOST_CHECK(state.stackHeight() == 4);
 	// One more than stack height because of the initial unknown element.
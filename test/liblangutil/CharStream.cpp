@@ -129,6 +129,66 @@ BOOST_AUTO_TEST_CASE(translateLineColumnToPosition)
 	BOOST_CHECK_EQUAL(toPosition(2, 0, "ABC\nDEF\nGHI\n"), 8);
 	BOOST_CHECK_EQUAL(toPosition(2, 1, "ABC\nDEF\nGHI\n"), 9);
 	BOOST_CHECK_EQUAL(toPosition(2, 2, "ABC\nDEF\nGHI\n"), 10);
+
+	BOOST_CHECK_EQUAL(toPosition(1, -1, "ABC\nDEF"), nullopt);
+}
+
+BOOST_AUTO_TEST_CASE(translatePositionToLineColumn)
+{
+	CharStream const stream{"ABC\nDEF\n\nGHI", "source"};
+	auto check = [&](int _position, int _line, int _column)
+	{
+		LineColumn const lineColumn = stream.translatePositionToLineColumn(_position);
+		BOOST_CHECK_EQUAL(lineColumn.line, _line);
+		BOOST_CHECK_EQUAL(lineColumn.column, _column);
+	};
+	check(0, 0, 0);
+	check(3, 0, 3);
+	check(4, 1, 0);
+	check(7, 1, 3);
+	check(8, 2, 0);
+	check(9, 3, 0);
+	check(12, 3, 3);
+	// Positions past the end are clamped.
+	check(100, 3, 3);
+
+	for (int position = 0; position <= static_cast<int>(stream.size()); ++position)
+		BOOST_CHECK_EQUAL(stream.translateLineColumnToPosition(stream.translatePositionToLineColumn(position)), position);
+}
+
+BOOST_AUTO_TEST_CASE(lineAtPosition)
+{
+	CharStream const stream{"\nABC\r\nDEF", "source"};
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(0), "");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(1), "ABC");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(5), "ABC");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(6), "DEF");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(9), "DEF");
+}
+
+BOOST_AUTO_TEST_CASE(translate_positions_in_large_source)
+{
+	// Translating every position used to scan the source from its start, which took more than
+	// half a minute for this source, while the index of line starts takes a few milliseconds.
+	size_t const lineCount = 50000;
+	string source;
+	vector<int> identifierPositions;
+	for (size_t line = 0; line < lineCount; ++line)
+	{
+		identifierPositions.push_back(static_cast<int>(source.size()) + 12);
+		source += "    uint256 x" + to_string(line) + " = " + to_string(line) + ";\n";
+	}
+	CharStream const stream{source, "source"};
+
+	for (size_t line = 0; line < lineCount; ++line)
+	{
+		int const position = identifierPositions[line];
+		LineColumn const lineColumn = stream.translatePositionToLineColumn(position);
+		BOOST_REQUIRE_EQUAL(lineColumn.line, static_cast<int>(line));
+		BOOST_REQUIRE_EQUAL(lineColumn.column, 12);
+		BOOST_REQUIRE_EQUAL(stream.translateLineColumnToPosition(lineColumn), position);
+	}
+	BOOST_CHECK_EQUAL(stream.translatePositionToLineColumn(static_cast<int>(source.size())).line, static_cast<int>(lineCount));
 }
 
 BOOST_AUTO_TEST_SUITE_END()
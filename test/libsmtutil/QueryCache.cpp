@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the persistent cache of solver answers.
+ */
+
+#include <libsmtutil/QueryCache.h>
+#include <libsmtutil/SMTLib2Interface.h>
+
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace solidity::smtutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(QueryCacheTest)
+
+BOOST_AUTO_TEST_CASE(smtlib2_answers_are_reused)
+{
+	size_t queries = 0;
+	string answer = "unsat\n";
+	ReadCallback::Callback solver = [&](string const& _kind, string const&) {
+		BOOST_REQUIRE(_kind == ReadCallback::kindString(ReadCallback::Kind::SMTQuery));
+		++queries;
+		return ReadCallback::Result{true, answer};
+	};
+
+	TemporaryDirectory cacheDirectory("solc-smt-query-cache-test-");
+	auto check = [&](size_t _bound) {
+		SMTLib2Interface interface({}, solver);
+		interface.setQueryCache(make_shared<QueryCache>(cacheDirectory.path()));
+		Expression x = interface.newVariable("x", SortProvider::sintSort);
+		interface.addAssertion(x > 0);
+		interface.addAssertion(x < _bound);
+		return interface.check({}).first;
+	};
+
+	BOOST_TEST((check(1) == CheckResult::UNSATISFIABLE));
+	BOOST_TEST(queries == 1);
+	BOOST_TEST((check(1) == CheckResult::UNSATISFIABLE));
+	BOOST_TEST(queries == 1);
+
+	// Answers that are not definitive are not stored.
+	answer = "unknown\n";
+	BOOST_TEST((check(2) == CheckResult::UNKNOWN));
+	BOOST_TEST((check(2) == CheckResult::UNKNOWN));
+	BOOST_TEST(queries == 3);
+}
+
+BOOST_AUTO_TEST_CASE(horn_answers_round_trip)
+{
+	auto tupleSort = make_shared<TupleSort>(
+		"state_type",
+		vector<string>{"balances", "counter"},
+		vector<SortPointer>{make_shared<ArraySort>(SortProvider::uintSort, SortProvider::uintSort), SortProvider::sintSort}
+	);
+	auto predicateSort = make_shared<FunctionSort>(vector<SortPointer>{tupleSort, SortProvider::boolSort}, SortProvider::boolSort);
+	Expression invariant("interface_C", {Expression(make_shared<SortSort>(tupleSort), "state"), Expression(true)}, predicateSort->codomain);
+
+	CHCSolverInterface::CexGraph cex;
+	cex.nodes.emplace(0, Expression("error_target", {Expression(size_t(3))}, SortProvider::boolSort));
+	cex.nodes.emplace(1, Expression("block_f", {Expression(size_t(7)), Expression(false)}, SortProvider::boolSort));
+	cex.edges[0] = {1};
+
+	string const encoded = QueryCache::encode(CheckResult::SATISFIABLE, invariant, cex);
+	auto decoded = QueryCache::decodeQueryResult(encoded);
+	BOOST_REQUIRE(decoded);
+	auto const& [result, decodedInvariant, decodedCex] = *decoded;
+	BOOST_TEST((result == CheckResult::SATISFIABLE));
+	BOOST_TEST((decodedInvariant.arguments.at(0).sort->kind == Kind::Sort));
+	BOOST_TEST((decodedCex.edges.at(0) == vector<unsigned>{1}));
+	BOOST_TEST(QueryCache::encode(result, decodedInvariant, decodedCex) == encoded);
+
+	BOOST_TEST(!QueryCache::decodeQueryResult("{\"result\": \"sat\", \"invariant\": {\"name\": \"x\", \"sort\": {\"kind\": \"float\"}}}"));
+	BOOST_TEST(!QueryCache::decodeCheckResult("not json"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,221 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for merging the results of racing solvers and interrupting the losers.
+ */
+
+#include <libsmtutil/SMTPortfolio.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+using namespace std;
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+/// Flag that threads can wait for.
+class Event
+{
+public:
+	void set()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_set = true;
+		m_condition.notify_all();
+	}
+	/// @returns false if the event was not set within a minute, which only happens if the
+	/// portfolio is broken. The limit keeps a broken portfolio from blocking the test run.
+	bool wait()
+	{
+		unique_lock<mutex> lock(m_mutex);
+		return m_condition.wait_for(lock, chrono::minutes(1), [&]() { return m_set; });
+	}
+
+private:
+	mutex m_mutex;
+	condition_variable m_condition;
+	bool m_set = false;
+};
+
+/// Solver that does not implement any theory.
+class FakeSolver: public SolverInterface
+{
+public:
+	void reset() override {}
+	void push() override {}
+	void pop() override {}
+	void declareVariable(string const&, SortPointer const&) override {}
+	void addAssertion(Expression const&) override {}
+	void interrupt() override { ++interrupts; }
+
+	atomic<size_t> interrupts{0};
+};
+
+/// Reports a fixed result. Waits for @a _before before it returns and sets @a _after right
+/// before it returns, so that tests can control the order in which solvers finish.
+class ScriptedSolver: public FakeSolver
+{
+public:
+	ScriptedSolver(CheckResult _result, vector<string> _values, Event* _before = nullptr, Event* _after = nullptr):
+		m_result(_result), m_values(std::move(_values)), m_before(_before), m_after(_after)
+	{}
+
+	pair<CheckResult, vector<string>> check(vector<Expression> const&) override
+	{
+		if (m_before && !m_before->wait())
+			return {CheckResult::ERROR, {}};
+		if (m_after)
+			m_after->set();
+		return {m_result, m_values};
+	}
+
+private:
+	CheckResult m_result;
+	vector<string> m_values;
+	Event* m_before = nullptr;
+	Event* m_after = nullptr;
+};
+
+/// Runs until it is interrupted. Like Z3 and CVC4, it drops interrupts that arrive before
+/// its query is running. Its query only starts once it has dropped an interrupt, so the
+/// portfolio has to interrupt it more than once.
+class InterruptibleSolver: public FakeSolver
+{
+public:
+	explicit InterruptibleSolver(Event& _started): m_started(_started) {}
+
+	pair<CheckResult, vector<string>> check(vector<Expression> const&) override
+	{
+		m_started.set();
+		unique_lock<mutex> lock(m_mutex);
+		if (!m_condition.wait_for(lock, chrono::minutes(1), [&]() { return droppedInterrupts > 0; }))
+			return {CheckResult::ERROR, {}};
+		m_running = true;
+		interruptedWhileRunning = m_condition.wait_for(lock, chrono::minutes(1), [&]() { return m_interrupted; });
+		m_running = false;
+		return {interruptedWhileRunning ? CheckResult::UNKNOWN : CheckResult::ERROR, {}};
+	}
+
+	void interrupt() override
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (m_running)
+			m_interrupted = true;
+		else
+			++droppedInterrupts;
+		m_condition.notify_all();
+	}
+
+	size_t droppedInterrupts = 0;
+	bool interruptedWhileRunning = false;
+
+private:
+	Event& m_started;
+	mutex m_mutex;
+	condition_variable m_condition;
+	bool m_running = false;
+	bool m_interrupted = false;
+};
+
+template <typename... Solvers>
+vector<unique_ptr<SolverInterface>> makeSolvers(unique_ptr<Solvers>... _solvers)
+{
+	vector<unique_ptr<SolverInterface>> solvers;
+	(solvers.emplace_back(std::move(_solvers)), ...);
+	return solvers;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioTest)
+
+BOOST_AUTO_TEST_CASE(race_prefers_earlier_solver_that_finishes_later)
+{
+	Event laterSolverDone;
+	auto earlier = make_unique<ScriptedSolver>(CheckResult::UNSATISFIABLE, vector<string>{"earlier"}, &laterSolverDone);
+	FakeSolver const& earlierSolver = *earlier;
+	SMTPortfolio portfolio(makeSolvers(
+		std::move(earlier),
+		make_unique<ScriptedSolver>(CheckResult::SATISFIABLE, vector<string>{"later"}, nullptr, &laterSolverDone)
+	), {}, true);
+
+	auto const [result, values] = portfolio.check({});
+	BOOST_TEST((result == CheckResult::UNSATISFIABLE));
+	BOOST_TEST(values == vector<string>{"earlier"});
+	BOOST_TEST(earlierSolver.interrupts == 0);
+}
+
+BOOST_AUTO_TEST_CASE(race_ignores_conflicting_answer_of_later_solver)
+{
+	auto makePortfolio = [](bool _race) {
+		return make_unique<SMTPortfolio>(makeSolvers(
+			make_unique<ScriptedSolver>(CheckResult::SATISFIABLE, vector<string>{"first"}),
+			make_unique<ScriptedSolver>(CheckResult::UNSATISFIABLE, vector<string>{})
+		), nullopt, _race);
+	};
+	BOOST_TEST((makePortfolio(false)->check({}).first == CheckResult::CONFLICTING));
+
+	auto const [result, values] = makePortfolio(true)->check({});
+	BOOST_TEST((result == CheckResult::SATISFIABLE));
+	BOOST_TEST(values == vector<string>{"first"});
+}
+
+BOOST_AUTO_TEST_CASE(race_takes_answer_after_non_answers)
+{
+	SMTPortfolio portfolio(makeSolvers(
+		make_unique<ScriptedSolver>(CheckResult::ERROR, vector<string>{}),
+		make_unique<ScriptedSolver>(CheckResult::UNKNOWN, vector<string>{}),
+		make_unique<ScriptedSolver>(CheckResult::UNSATISFIABLE, vector<string>{"last"})
+	), {}, true);
+	auto const [result, values] = portfolio.check({});
+	BOOST_TEST((result == CheckResult::UNSATISFIABLE));
+	BOOST_TEST(values == vector<string>{"last"});
+
+	SMTPortfolio noAnswer(makeSolvers(
+		make_unique<ScriptedSolver>(CheckResult::ERROR, vector<string>{}),
+		make_unique<ScriptedSolver>(CheckResult::UNKNOWN, vector<string>{})
+	), {}, true);
+	BOOST_TEST((noAnswer.check({}).first == CheckResult::UNKNOWN));
+}
+
+BOOST_AUTO_TEST_CASE(race_interrupts_later_solver_until_it_returns)
+{
+	Event laterSolverStarted;
+	auto interruptible = make_unique<InterruptibleSolver>(laterSolverStarted);
+	InterruptibleSolver const& laterSolver = *interruptible;
+	SMTPortfolio portfolio(makeSolvers(
+		make_unique<ScriptedSolver>(CheckResult::SATISFIABLE, vector<string>{}, &laterSolverStarted),
+		std::move(interruptible)
+	), {}, true);
+
+	BOOST_TEST((portfolio.check({}).first == CheckResult::SATISFIABLE));
+	BOOST_TEST(laterSolver.droppedInterrupts >= 1);
+	BOOST_TEST(laterSolver.interruptedWhileRunning);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -486,6 +486,41 @@ BOOST_AUTO_TEST_CASE(metadata_optimiser_sequence)
 		check(sequence, cleanupSequence);
 }
 
+BOOST_AUTO_TEST_CASE(metadata_optimiser_max_iterations)
+{
+	char const* sourceCode = R"(
+		pragma solidity >=0.0;
+		contract C {
+		}
+	)";
+
+	auto compile = [&](optional<size_t> _maxIterations) {
+		OptimiserSettings optimizerSettings = OptimiserSettings::standard();
+		if (_maxIterations)
+			optimizerSettings.maxIterations = *_maxIterations;
+		CompilerStack compilerStack;
+		compilerStack.setSources({{"", sourceCode}});
+		compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compilerStack.setOptimiserSettings(optimizerSettings);
+		BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+
+		Json::Value metadata;
+		BOOST_REQUIRE(util::jsonParseStrict(compilerStack.metadata("C"), metadata));
+		BOOST_CHECK(solidity::test::isValidMetadata(metadata));
+		return make_pair(metadata, compilerStack.cborMetadata("C"));
+	};
+
+	auto const [defaultMetadata, defaultCBOR] = compile(nullopt);
+	BOOST_CHECK(!defaultMetadata["settings"]["optimizer"].isMember("maxIterations"));
+	BOOST_CHECK(compile(OptimiserSettings{}.maxIterations).second == defaultCBOR);
+
+	// A different limit can lead to different code, so it has to change the metadata hash.
+	auto const [metadata, cbor] = compile(10);
+	BOOST_CHECK_EQUAL(metadata["settings"]["optimizer"]["maxIterations"].asUInt(), 10);
+	BOOST_CHECK_EQUAL(metadata["settings"]["optimizer"]["enabled"].asBool(), true);
+	BOOST_CHECK(cbor != defaultCBOR);
+}
+
 BOOST_AUTO_TEST_CASE(metadata_license_missing)
 {
 	char const* sourceCode = R"(
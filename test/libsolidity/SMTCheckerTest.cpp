@@ -60,6 +60,11 @@ SMTCheckerTest::SMTCheckerTest(string const& _filename): SyntaxTest(_filename, E
 	else
 		BOOST_THROW_EXCEPTION(runtime_error("Invalid SMT engine choice."));
 
+	size_t const jobs = m_reader.sizetSetting("SMTJobs", 1);
+	if (jobs == 0)
+		BOOST_THROW_EXCEPTION(runtime_error("Invalid SMT jobs choice."));
+	m_modelCheckerSettings.jobs = static_cast<unsigned>(jobs);
+
 	if (m_modelCheckerSettings.solvers.none() || m_modelCheckerSettings.engine.none())
 		m_shouldRun = false;
 
@@ -51,6 +51,8 @@ protected:
 		Set in m_ignoreCex.
 	SMTIgnoreInv: `yes`, `no`, where the default is `no`.
 		Set in m_modelCheckerSettings.
+	SMTJobs: number of threads used to check the targets, where the default is 1.
+		Set in m_modelCheckerSettings.
 	SMTShowUnproved: `yes`, `no`, where the default is `yes`.
 		Set in m_modelCheckerSettings.
 	SMTSolvers: `all`, `cvc4`, `z3`, `none`, where the default is `all`.
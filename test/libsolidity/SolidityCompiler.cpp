@@ -22,9 +22,16 @@
 #include <test/Metadata.h>
 #include <test/Common.h>
 
+#include <libsolidity/codegen/ir/Common.h>
+
+#include <libyul/YulStack.h>
+
+#include <libevmasm/Assembly.h>
+
 #include <boost/test/unit_test.hpp>
 
 using namespace std;
+using namespace solidity::langutil;
 
 namespace solidity::frontend::test
 {
@@ -51,6 +58,75 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(via_ir_output_matches_reparsed_optimized_ir)
+{
+	// The code is generated from the optimized IR without printing and parsing it again.
+	// The output has to be the same as when doing so.
+	char const* sourceCode = R"(
+		contract D {
+			uint public x;
+			constructor(uint _x) { x = _x; }
+		}
+		contract C {
+			uint[] data;
+			function f(uint n) public returns (uint sum) {
+				for (uint i = 0; i < n; ++i)
+				{
+					data.push(i * 3);
+					sum += data[i];
+				}
+				require(sum < 1000, "too large");
+			}
+			function g() public returns (address) {
+				return address(new D(f(3)));
+			}
+		}
+	)";
+	for (DebugInfoSelection const& debugInfo: {DebugInfoSelection::All(), DebugInfoSelection::Only(&DebugInfoSelection::location)})
+	{
+		CompilerStack compilerStack;
+		compilerStack.setSources({{"A.sol", sourceCode}});
+		compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compilerStack.setOptimiserSettings(OptimiserSettings::standard());
+		compilerStack.setViaIR(true);
+		compilerStack.enableIRGeneration();
+		compilerStack.selectDebugInfo(debugInfo);
+		BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+
+		for (string const contractName: {"C", "D"})
+		{
+			yul::YulStack stack(
+				solidity::test::CommonOptions::get().evmVersion(),
+				nullopt,
+				yul::YulStack::Language::StrictAssembly,
+				OptimiserSettings::standard(),
+				debugInfo
+			);
+			BOOST_REQUIRE(stack.parseAndAnalyze("", compilerStack.yulIROptimized(contractName)));
+			stack.optimize();
+			auto [assembly, runtimeAssembly] = stack.assembleEVMWithDeployed(
+				IRNames::deployedObject(compilerStack.contractDefinition(contractName))
+			);
+			BOOST_REQUIRE(assembly && runtimeAssembly);
+
+			BOOST_CHECK(compilerStack.object(contractName).bytecode == assembly->assemble().bytecode);
+			BOOST_CHECK(compilerStack.runtimeObject(contractName).bytecode == runtimeAssembly->assemble().bytecode);
+			BOOST_CHECK_EQUAL(
+				*compilerStack.sourceMapping(contractName),
+				evmasm::AssemblyItem::computeSourceMapping(assembly->items(), compilerStack.sourceIndices())
+			);
+			BOOST_CHECK_EQUAL(
+				*compilerStack.runtimeSourceMapping(contractName),
+				evmasm::AssemblyItem::computeSourceMapping(runtimeAssembly->items(), compilerStack.sourceIndices())
+			);
+			BOOST_CHECK_EQUAL(
+				compilerStack.assemblyString(contractName),
+				assembly->assemblyString(debugInfo)
+			);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
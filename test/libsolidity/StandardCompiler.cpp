@@ -26,10 +26,13 @@
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/TemporaryDirectory.h>
 #include <test/Metadata.h>
 
 #include <algorithm>
+#include <ctime>
 #include <set>
 
 using namespace std;
@@ -1815,6 +1818,148 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	string input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "import \"B.sol\"; contract A is B { function f() public pure returns (uint) { return 1; } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": { "A": ["evm.bytecode.object", "abi"] }
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	string importedSource = "contract B {}";
+	ReadCallback::Callback readFile = [&](string const& _kind, string const& _path) {
+		if (_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile) && _path == "B.sol")
+			return ReadCallback::Result{true, importedSource};
+		return ReadCallback::Result{false, "File not found."};
+	};
+
+	util::TemporaryDirectory cacheDirectory("solc-compilation-cache-test-");
+	auto cache = make_shared<CompilationCache>(cacheDirectory.path());
+
+	Json::Value result = solidity::frontend::StandardCompiler(readFile, {}, cache).compile(parsedInput);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_TEST(cache->hits() == 0);
+	BOOST_TEST(cache->misses() == 1);
+
+	BOOST_TEST(solidity::frontend::StandardCompiler(readFile, {}, cache).compile(parsedInput) == result);
+	BOOST_TEST(cache->hits() == 1);
+
+	// A change to an imported file invalidates the entry.
+	importedSource = "contract B { function g() public {} }";
+	Json::Value changedResult = solidity::frontend::StandardCompiler(readFile, {}, cache).compile(parsedInput);
+	BOOST_REQUIRE(containsAtMostWarnings(changedResult));
+	BOOST_TEST(cache->hits() == 1);
+	BOOST_TEST(cache->misses() == 2);
+	BOOST_TEST(changedResult != result);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_eviction)
+{
+	util::TemporaryDirectory cacheDirectory("solc-compilation-cache-test-");
+	Json::Value output{Json::objectValue};
+	output["data"] = string(100, 'x');
+	vector<util::h256> keys;
+	for (size_t i = 0; i < 5; ++i)
+		keys.push_back(util::keccak256(to_string(i)));
+
+	// Each entry takes more than 100 bytes, so only four of them fit.
+	CompilationCache cache(cacheDirectory.path(), 500);
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		cache.store(keys[i], output, {});
+		// Make the order of use unambiguous despite the coarse file times.
+		boost::filesystem::last_write_time(
+			cacheDirectory.path() / (keys[i].hex() + ".json"),
+			time(nullptr) - static_cast<time_t>(100 * (keys.size() - i))
+		);
+	}
+
+	size_t entries = 0;
+	for (boost::filesystem::directory_iterator it(cacheDirectory.path()), end; it != end; ++it)
+		if (it->path().extension() == ".json")
+			++entries;
+	// Eviction frees a quarter of the limit, so that it is not needed on every store.
+	BOOST_TEST(entries == 3);
+	BOOST_TEST(!cache.load(keys[0], {}).has_value());
+	BOOST_TEST(!cache.load(keys[1], {}).has_value());
+	BOOST_TEST(cache.load(keys[4], {}).has_value());
+
+	// Replacing an entry does not count its size twice.
+	for (size_t i = 0; i < 10; ++i)
+		cache.store(keys[4], output, {});
+	BOOST_TEST(cache.load(keys[2], {}).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x) public pure returns (uint) { return x * 2 + 1; } }"
+			}
+		},
+		"settings": {
+			"optimizer": { "enabled": true },
+			"debug": { "profile": true },
+			"outputSelection": {
+				"fileA": { "A": ["evm.bytecode.object"] }
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	for (bool viaIR: {false, true})
+	{
+		parsedInput["settings"]["viaIR"] = viaIR;
+		Json::Value result = compiler.compile(parsedInput);
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		Json::Value profile = getContractResult(result, "fileA", "A")["optimizerProfile"];
+		BOOST_REQUIRE(profile.isObject());
+		BOOST_REQUIRE(!profile.empty());
+
+		bool hasEVMAssemblyPass = false;
+		bool hasYulStep = false;
+		for (string const& object: profile.getMemberNames())
+			for (string const& step: profile[object].getMemberNames())
+			{
+				Json::Value const& statistics = profile[object][step];
+				BOOST_TEST(statistics["invocations"].asUInt64() > 0);
+				BOOST_TEST(statistics["durationMicroseconds"].isIntegral());
+				BOOST_TEST(statistics["sizeBefore"].isIntegral());
+				BOOST_TEST(statistics["sizeAfter"].isIntegral());
+				if (step == "evmasm:PeepholeOptimiser")
+					hasEVMAssemblyPass = true;
+				// Steps of the Yul optimizer are recorded by their abbreviation.
+				if (step == "s")
+					hasYulStep = true;
+			}
+		BOOST_TEST(hasEVMAssemblyPass);
+		if (viaIR)
+			BOOST_TEST(hasYulStep);
+	}
+
+	parsedInput["settings"]["debug"]["profile"] = "yes";
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsError(result, "JSONError", "settings.debug.profile must be a Boolean."));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: UNLICENSED
+pragma solidity >=0.8.0;
+
+contract C
+{
+    uint counter;
+//       ^^^^^^^ @CounterDeclaration
+//          ^ @CursorOnCounterDeclaration
+
+    function increment() public
+    {
+        counter += 1;
+//      ^^^^^^^ @CounterInIncrement
+    }
+
+    function get() public view returns (uint)
+    {
+        return counter;
+//             ^^^^^^^ @CounterInGet
+//                ^ @CursorOnCounterInGet
+    }
+}
+// ----
+// -> textDocument/references {
+//     "position": @CursorOnCounterInGet,
+//     "context": { "includeDeclaration": true }
+// }
+// <- [
+//     {
+//         "range": @CounterDeclaration,
+//         "uri": "variable.sol"
+//     },
+//     {
+//         "range": @CounterInIncrement,
+//         "uri": "variable.sol"
+//     },
+//     {
+//         "range": @CounterInGet,
+//         "uri": "variable.sol"
+//     }
+// ]
+// -> textDocument/references {
+//     "position": @CursorOnCounterDeclaration,
+//     "context": { "includeDeclaration": false }
+// }
+// <- [
+//     {
+//         "range": @CounterInIncrement,
+//         "uri": "variable.sol"
+//     },
+//     {
+//         "range": @CounterInGet,
+//         "uri": "variable.sol"
+//     }
+// ]
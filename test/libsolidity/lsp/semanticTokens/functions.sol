@@ -28,6 +28,7 @@ contract Contract
 // -> textDocument/semanticTokens/full {
 // }
 // <- {
+//     "resultId": "1",
 //     "data": [
 //         1, 0, 24, 8, 0,
 //         2, 8, 3, 0, 0,
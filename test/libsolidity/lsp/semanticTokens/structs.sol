@@ -23,6 +23,7 @@ function memberAccess(RGBColor memory color) pure returns(uint)
 // -> textDocument/semanticTokens/full {
 // }
 // <- {
+//     "resultId": "1",
 //     "data": [
 //         1, 0, 24, 8, 0,
 //         4, 4, 4, 11, 0,
@@ -241,6 +241,26 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(template_reuse)
+{
+	string templ = "<?c><a><!c><#l><a><b></l></c>";
+	vector<map<string, string>> list(2);
+	list[0]["b"] = "1";
+	list[1]["b"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "x")("c", true)("l", list).render(), "x");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "y")("c", false)("l", list).render(), "y1y2");
+	Whiskers m(templ);
+	m("c", true)("l", list);
+	BOOST_CHECK_THROW(m.render(), WhiskersError);
+}
+
+BOOST_AUTO_TEST_CASE(unclosed_tags_as_text)
+{
+	string templ = "<#l>x<?c>y<!c>z";
+	BOOST_CHECK_EQUAL(Whiskers(templ).render(), templ);
+	BOOST_CHECK_THROW(Whiskers("a <?c b</c>"), WhiskersError);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
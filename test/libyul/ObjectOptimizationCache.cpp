@@ -0,0 +1,112 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the keys of the cache of optimized Yul objects.
+ */
+
+#include <test/libyul/Common.h>
+
+#include <libyul/ObjectOptimizationCache.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+util::h256 cacheKey(
+	string const& _source,
+	EVMVersion _evmVersion = EVMVersion{},
+	OptimiserSettings const& _settings = OptimiserSettings::standard()
+)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(_evmVersion);
+	ErrorList errors;
+	shared_ptr<Object> object = parse(_source, dialect, errors).first;
+	BOOST_REQUIRE(object);
+	return ObjectOptimizationCache::cacheKey(*object, dialect, false, _settings);
+}
+
+string const code = R"(
+	/// @use-src 0:"a.sol"
+	object "A" {
+		code {
+			/// @src 0:10:20
+			let x := calldataload(0)
+			sstore(x, add(x, 1))
+		}
+	}
+)";
+
+string replace(string _source, string const& _from, string const& _to)
+{
+	size_t position = _source.find(_from);
+	BOOST_REQUIRE(position != string::npos);
+	return _source.replace(position, _from.size(), _to);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulObjectOptimizationCache)
+
+BOOST_AUTO_TEST_CASE(same_code)
+{
+	BOOST_CHECK(cacheKey(code) == cacheKey(code));
+	// Only the locations in the Yul source differ.
+	BOOST_CHECK(cacheKey(code) == cacheKey("\n\n" + code));
+}
+
+BOOST_AUTO_TEST_CASE(different_code)
+{
+	BOOST_CHECK(cacheKey(code) != cacheKey(replace(code, "add(x, 1)", "add(x, 2)")));
+	BOOST_CHECK(cacheKey(code) != cacheKey(replace(code, "sstore", "mstore")));
+}
+
+BOOST_AUTO_TEST_CASE(different_names)
+{
+	BOOST_CHECK(cacheKey(code) != cacheKey(replace(replace(replace(code, "x :=", "y :="), "(x,", "(y,"), "(x, 1", "(y, 1")));
+	BOOST_CHECK(cacheKey(code) != cacheKey(replace(code, "object \"A\"", "object \"B\"")));
+}
+
+BOOST_AUTO_TEST_CASE(different_debug_data)
+{
+	BOOST_CHECK(cacheKey(code) != cacheKey(replace(code, "@src 0:10:20", "@src 0:10:21")));
+	BOOST_CHECK(cacheKey(code) != cacheKey(replace(code, "0:\"a.sol\"", "0:\"b.sol\"")));
+}
+
+BOOST_AUTO_TEST_CASE(different_dialect_and_settings)
+{
+	BOOST_CHECK(cacheKey(code) != cacheKey(code, EVMVersion::homestead()));
+	BOOST_CHECK(cacheKey(code) != cacheKey(code, EVMVersion{}, OptimiserSettings::minimal()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
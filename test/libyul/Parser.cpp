@@ -951,6 +951,44 @@ BOOST_AUTO_TEST_CASE(customSourceLocations_multiple_src_tags_on_one_line)
 	CHECK_LOCATION(varX.debugData->originLocation, "source1", 4, 5);
 }
 
+BOOST_AUTO_TEST_CASE(debugData_stored_once)
+{
+	static_assert(sizeof(DebugDataHandle) == 4);
+	BOOST_CHECK(!DebugDataHandle{});
+
+	auto const sourceName = make_shared<string const>("source0");
+	DebugDataHandle const debugData = DebugData::create(SourceLocation{1, 2, sourceName}, SourceLocation{3, 4, sourceName}, 5);
+	CHECK_LOCATION(debugData->nativeLocation, "source0", 1, 2);
+	CHECK_LOCATION(debugData->originLocation, "source0", 3, 4);
+	BOOST_CHECK(debugData->astID == 5);
+
+	DebugDataHandle const equalDebugData = DebugData::create(
+		SourceLocation{1, 2, make_shared<string const>("source0")},
+		SourceLocation{3, 4, sourceName},
+		5
+	);
+	BOOST_CHECK(equalDebugData == debugData);
+	BOOST_CHECK(equalDebugData.get() == debugData.get());
+	BOOST_CHECK(DebugData::create(SourceLocation{1, 2, sourceName}, SourceLocation{3, 4, sourceName}, 6) != debugData);
+	BOOST_CHECK(DebugData::create(SourceLocation{1, 2, sourceName}, SourceLocation{3, 5, sourceName}) != debugData);
+
+	// Parsing the same code again does not store any new debug data.
+	auto const sourceText =
+		"/// @src 0:10:20\n"
+		"{ let x := 1 /** @src 0:20:30 */ sstore(x, 2) }\n";
+	ErrorList errorList;
+	ErrorReporter reporter(errorList);
+	EVMDialectTyped const& dialect = EVMDialectTyped::instance(EVMVersion{});
+	shared_ptr<Block> result = parse(sourceText, dialect, reporter);
+	shared_ptr<Block> repeatedResult = parse(sourceText, dialect, reporter);
+	BOOST_REQUIRE(!!result && !!repeatedResult && errorList.size() == 0);
+	BOOST_CHECK(result->debugData == repeatedResult->debugData);
+	BOOST_REQUIRE_EQUAL(result->statements.size(), 2);
+	BOOST_CHECK(debugDataOf(result->statements.at(0)) == debugDataOf(repeatedResult->statements.at(0)));
+	BOOST_CHECK(debugDataOf(result->statements.at(1)) == debugDataOf(repeatedResult->statements.at(1)));
+	BOOST_CHECK(debugDataOf(result->statements.at(0)) != debugDataOf(result->statements.at(1)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
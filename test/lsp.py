@@ -10,6 +10,7 @@ import os
 import re
 import subprocess
 import sys
+import tempfile
 import traceback
 from collections import namedtuple
 from copy import deepcopy
@@ -225,17 +226,25 @@ class JsonRpcProcess:
         return json_object
 
     def send_message(self, method_name: str, params: Optional[dict]) -> None:
+        self.send_messages([(method_name, params)])
+
+    def send_messages(self, messages: List[Tuple[str, Optional[dict]]]) -> None:
+        """
+        Sends all messages with a single write, so that the server receives them without any pause in between.
+        """
         if self.process.stdin is None:
             return
-        message = {
-            'jsonrpc': '2.0',
-            'method': method_name,
-            'params': params
-        }
-        json_string = json.dumps(obj=message)
-        rpc_message = f"Content-Length: {len(json_string)}\r\n\r\n{json_string}"
-        self.trace(f'send_message ({method_name})', json.dumps(message, indent=4, sort_keys=True))
-        self.process.stdin.write(rpc_message.encode("utf-8"))
+        rpc_messages = ""
+        for method_name, params in messages:
+            message = {
+                'jsonrpc': '2.0',
+                'method': method_name,
+                'params': params
+            }
+            json_string = json.dumps(obj=message)
+            rpc_messages += f"Content-Length: {len(json_string)}\r\n\r\n{json_string}"
+            self.trace(f'send_message ({method_name})', json.dumps(message, indent=4, sort_keys=True))
+        self.process.stdin.write(rpc_messages.encode("utf-8"))
         self.process.stdin.flush()
 
     def call_method(self, method_name: str, params: Optional[dict], expects_response: bool = True) -> Any:
@@ -2050,6 +2059,133 @@ class SolidityLSPTestSuite: # {{{
             "diagnostic: check range"
         )
 
+    def test_textDocument_didChange_burst_is_analyzed_once(self, solc: JsonRpcProcess) -> None:
+        """
+        Sends several changes without pausing and expects the diagnostics
+        to be published only once, for the final content.
+        """
+        self.setup_lsp(solc)
+        FILE_NAME = 'didChange_template'
+        FILE_URI = self.get_test_file_uri(FILE_NAME)
+        burst: List[Tuple[str, Optional[dict]]] = [('textDocument/didOpen', {
+            'textDocument': {
+                'uri': FILE_URI,
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': self.get_test_file_contents(FILE_NAME)
+            }
+        })]
+        for text in ['function f() public { uint x; }\n', 'function g() public { uint y; }\n', '']:
+            burst.append(('textDocument/didChange', {
+                'textDocument': { 'uri': FILE_URI },
+                'contentChanges': [
+                    {
+                        'range': {
+                            'start': { 'line': 5, 'character': 0 },
+                            'end': { 'line': 5, 'character': 0 }
+                        },
+                        'text': text
+                    }
+                ]
+            }))
+        solc.send_messages(burst)
+        published_diagnostics = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(published_diagnostics), 1, "one publish diagnostics notification")
+        codes = [diagnostic['code'] for diagnostic in published_diagnostics[0]['diagnostics']]
+        self.expect_equal(codes.count(2072), 2, "unused variables of all changes")
+
+        # The next message has to be the reply, not diagnostics of an intermediate state.
+        reply = solc.call_method('textDocument/semanticTokens/full', {'textDocument': {'uri': FILE_URI}})
+        self.expect_true('result' in reply, "reply to the request")
+
+        # A change after the pause is analyzed on its own.
+        solc.send_message('textDocument/didChange', {
+            'textDocument': { 'uri': FILE_URI },
+            'contentChanges': [{ 'text': self.get_test_file_contents(FILE_NAME) }]
+        })
+        published_diagnostics = self.wait_for_diagnostics(solc)
+        codes = [diagnostic['code'] for diagnostic in published_diagnostics[0]['diagnostics']]
+        self.expect_equal(codes.count(2072), 0, "diagnostics of the reverted content")
+
+    def test_unchanged_sources_are_not_analyzed_again(self, solc: JsonRpcProcess) -> None:
+        """
+        Requests the semantic tokens repeatedly. They are only rebuilt
+        if the sources or the configuration changed.
+        """
+        self.setup_lsp(solc)
+        FILE_NAME = 'didChange_template'
+        FILE_URI = self.get_test_file_uri(FILE_NAME)
+        solc.send_message('textDocument/didOpen', {
+            'textDocument': {
+                'uri': FILE_URI,
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': self.get_test_file_contents(FILE_NAME)
+            }
+        })
+        self.wait_for_diagnostics(solc)
+
+        def semantic_tokens_result_id():
+            reply = solc.call_method('textDocument/semanticTokens/full', {'textDocument': {'uri': FILE_URI}})
+            return reply['result']['resultId']
+
+        result_id = semantic_tokens_result_id()
+        self.expect_equal(semantic_tokens_result_id(), result_id, "tokens kept for unchanged sources")
+
+        solc.send_message('textDocument/didChange', {
+            'textDocument': { 'uri': FILE_URI },
+            'contentChanges': [{ 'text': self.get_test_file_contents(FILE_NAME) }]
+        })
+        self.wait_for_diagnostics(solc)
+        self.expect_equal(semantic_tokens_result_id(), result_id, "tokens kept for identical content")
+
+        solc.send_notification('workspace/didChangeConfiguration', {
+            'settings': { 'file-load-strategy': FileLoadStrategy.DirectlyOpenedAndOnImport.value }
+        })
+        self.expect_equal(
+            semantic_tokens_result_id(),
+            str(int(result_id) + 1),
+            "tokens rebuilt after the configuration changed"
+        )
+
+    def test_imported_file_changed_on_disk(self, solc: JsonRpcProcess) -> None:
+        """
+        Changes a file that is only imported and not open in between two analyses
+        and expects the second one to see the new content.
+        """
+        self.setup_lsp(solc, expose_project_root=False)
+        with tempfile.TemporaryDirectory() as directory:
+            imported_path = PurePath(directory, 'b.sol')
+            header = '// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\n'
+            with open(imported_path, mode='w', encoding='utf-8', newline='') as f:
+                f.write(header + 'contract B {}\n')
+
+            FILE_A_URI = PurePath(directory, 'a.sol').as_uri()
+            FILE_A_TEXT = header + 'import "./b.sol";\n'
+            solc.send_message('textDocument/didOpen', {
+                'textDocument': {
+                    'uri': FILE_A_URI,
+                    'languageId': 'Solidity',
+                    'version': 1,
+                    'text': FILE_A_TEXT
+                }
+            })
+            reports = self.wait_for_diagnostics(solc)
+            self.expect_equal(len(reports), 2, "diagnostics for both files")
+            self.expect_equal(len(reports[1]['diagnostics']), 0, "should not contain diagnostics")
+
+            with open(imported_path, mode='w', encoding='utf-8', newline='') as f:
+                f.write(header + 'contract B { function f() public { uint x; } }\n')
+
+            solc.send_message('textDocument/didChange', {
+                'textDocument': { 'uri': FILE_A_URI },
+                'contentChanges': [{ 'text': FILE_A_TEXT }]
+            })
+            reports = self.wait_for_diagnostics(solc)
+            self.expect_equal(len(reports), 2, "diagnostics for both files")
+            self.expect_equal(reports[1]['uri'], imported_path.as_uri(), "Correct uri")
+            self.expect_equal(len(reports[1]['diagnostics']), 2, "diagnostics of the new content")
+
     # }}}
     # }}}
 
@@ -398,6 +398,29 @@ BOOST_AUTO_TEST_CASE(standard_json_remapping)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(standard_json_cache_statistics)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	string const standardJsonInput = R"(
+		{
+			"language": "Solidity",
+			"sources": {"A.sol": {"content": "contract A {}"}}
+		}
+	)";
+	vector<string> commandLine = {"solc", "--standard-json", "--cache-dir=" + tempDir.path().string()};
+
+	OptionsReaderAndMessages result = runCLI(commandLine, standardJsonInput);
+	BOOST_REQUIRE(result.success);
+	BOOST_TEST(result.stderrContent == "Compilation cache: 0 hit(s), 1 miss(es).\n");
+
+	OptionsReaderAndMessages cachedResult = runCLI(commandLine, standardJsonInput);
+	BOOST_REQUIRE(cachedResult.success);
+	BOOST_TEST(cachedResult.stderrContent == "Compilation cache: 1 hit(s), 0 miss(es).\n");
+	BOOST_TEST(cachedResult.stdoutContent == result.stdoutContent);
+
+	BOOST_TEST(runCLI({"solc", "--standard-json"}, standardJsonInput).stderrContent == "");
+}
+
 BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_no_base_path)
 {
 	TemporaryDirectory tempDirCurrent(TEST_CASE_NAME);
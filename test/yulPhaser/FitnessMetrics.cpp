@@ -277,6 +277,29 @@ BOOST_FIXTURE_TEST_CASE(FitnessMetricMinimum_evaluate_should_compute_minimum_of_
 	BOOST_TEST(metric.metrics() == m_simpleMetrics);
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(EvaluateAllTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_return_the_same_values_regardless_of_thread_count, ProgramBasedMetricFixture)
+{
+	vector<Chromosome> chromosomes = {m_chromosome, Chromosome("")};
+	for (size_t i = 0; i < 30; ++i)
+		chromosomes.push_back(Chromosome::makeRandom(i % 10));
+
+	vector<size_t> expectedFitness;
+	for (Chromosome const& chromosome: chromosomes)
+		expectedFitness.push_back(ProgramSize(m_program, nullptr, m_weights).evaluate(chromosome));
+
+	ProgramSize metricWithoutCache(m_program, nullptr, m_weights);
+	metricWithoutCache.setThreadCount(4);
+	BOOST_TEST(metricWithoutCache.evaluateAll(chromosomes) == expectedFitness);
+
+	ProgramSize metricWithCache(nullopt, m_programCache, m_weights);
+	metricWithCache.setThreadCount(4);
+	BOOST_TEST(metricWithCache.evaluateAll(chromosomes) == expectedFitness);
+	BOOST_TEST(metricWithCache.evaluateAll(chromosomes) == expectedFitness);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
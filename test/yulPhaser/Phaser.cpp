@@ -237,6 +237,17 @@ BOOST_FIXTURE_TEST_CASE(build_should_set_relative_metric_scale, FitnessMetricFac
 	BOOST_TEST(relativeProgramSizeMetric->fixedPointPrecision() == m_options.relativeMetricScale);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_set_thread_count_of_the_top_level_metric, FitnessMetricFactoryFixture)
+{
+	m_options.threadCount = 4;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+	BOOST_TEST(metric->threadCount() == 4);
+
+	m_options.threadCount = 0;
+	BOOST_CHECK_THROW(FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights), BadInput);
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_create_metric_for_each_input_program, FitnessMetricFactoryFixture)
 {
 	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(
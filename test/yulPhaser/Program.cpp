@@ -22,6 +22,7 @@
 #include <tools/yulPhaser/Program.h>
 
 #include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 
@@ -60,24 +61,58 @@ namespace solidity::phaser::test
 BOOST_AUTO_TEST_SUITE(Phaser, *boost::unit_test::label("nooptions"))
 BOOST_AUTO_TEST_SUITE(ProgramTest)
 
-BOOST_AUTO_TEST_CASE(copy_constructor_should_make_deep_copy_of_ast)
+BOOST_AUTO_TEST_CASE(copy_constructor_should_share_ast_until_one_of_the_copies_is_optimised)
 {
 	string sourceCode(
 		"{\n"
-		"    let x := 1\n"
+		"    if 0 { let x := 1 }\n"
 		"}\n"
 	);
 	CharStream sourceStream(sourceCode, current_test_case().p_name);
 	Program program = get<Program>(Program::load(sourceStream));
+	string const originalJson = program.toJson();
 
 	Program programCopy(program);
+	BOOST_TEST(&programCopy.ast() == &program.ast());
 
+	programCopy.optimise({StructuralSimplifier::name});
 	BOOST_TEST(&programCopy.ast() != &program.ast());
 
 	// There might be a more direct way to compare ASTs but converting to JSON should be good enough
 	// as long as the conversion is deterministic. A very nice side effect of doing it this way is
 	// that BOOST_TEST will print the complete AST structure of both programs in case of a mismatch.
-	BOOST_TEST(programCopy.toJson() == program.toJson());
+	BOOST_TEST(program.toJson() == originalJson);
+	BOOST_TEST(programCopy.toJson() != originalJson);
+}
+
+BOOST_AUTO_TEST_CASE(codeHash_should_change_with_code_and_names)
+{
+	string sourceCode(
+		"{\n"
+		"    function f(a) -> b { b := add(a, 1) }\n"
+		"    let x := f(2)\n"
+		"}\n"
+	);
+	CharStream sourceStream(sourceCode, current_test_case().p_name);
+	Program program = get<Program>(Program::load(sourceStream));
+	BOOST_TEST(Program(program).codeHash() == program.codeHash());
+
+	auto codeHashOf = [](string _source) {
+		CharStream stream(_source, current_test_case().p_name);
+		return get<Program>(Program::load(stream)).codeHash();
+	};
+	BOOST_TEST(codeHashOf(sourceCode) == program.codeHash());
+	BOOST_TEST(codeHashOf("{ function f(a) -> b { b := add(a, 2) } let x := f(2) }") != program.codeHash());
+	BOOST_TEST(codeHashOf("{ function f(a) -> c { c := add(a, 1) } let x := f(2) }") != program.codeHash());
+	BOOST_TEST(codeHashOf("{ function g(a) -> b { b := add(a, 1) } let x := g(2) }") != program.codeHash());
+	BOOST_TEST(codeHashOf("{ function f(a) -> b { b := add(a, 1) } let y := f(2) }") != program.codeHash());
+	BOOST_TEST(codeHashOf("{ function f(a) -> b { b := add(a, 1) } let x := f(0x02) }") == program.codeHash());
+
+	Program optimisedProgram(program);
+	optimisedProgram.optimise({StructuralSimplifier::name});
+	BOOST_TEST(optimisedProgram.codeHash() == program.codeHash());
+	optimisedProgram.optimise({ExpressionSplitter::name});
+	BOOST_TEST(optimisedProgram.codeHash() != program.codeHash());
 }
 
 BOOST_AUTO_TEST_CASE(load_should_rewind_the_stream)
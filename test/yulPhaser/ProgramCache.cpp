@@ -163,6 +163,36 @@ BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_reuse_the_longest_prefix_and_move
 	BOOST_TEST(m_programCache.entries().find("IuOI")->second.roundNumber == 1);
 }
 
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_share_the_ast_of_prefixes_after_steps_that_do_not_change_it, ProgramCacheFixture)
+{
+	Program expectedProgram = optimisedProgram(m_program, "IfuOf");
+
+	Program cachedProgram = m_programCache.optimiseProgram("IfuOf");
+
+	BOOST_TEST(toString(cachedProgram) == toString(expectedProgram));
+	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"I", "If", "IfuO", "Ifu", "IfuOf"}));
+	// The AST is already flat after the first step.
+	BOOST_TEST(&m_programCache.find("If")->ast() == &m_programCache.find("I")->ast());
+	BOOST_TEST(&m_programCache.find("IfuOf")->ast() == &m_programCache.find("IfuO")->ast());
+	BOOST_TEST(&m_programCache.find("Ifu")->ast() != &m_programCache.find("If")->ast());
+	BOOST_TEST(&cachedProgram.ast() == &m_programCache.find("IfuOf")->ast());
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_not_copy_the_ast_for_steps_that_did_not_change_the_same_code_before, ProgramCacheFixture)
+{
+	// load() already hoisted and grouped the functions, so neither step changes the code.
+	Program cachedProgramG = m_programCache.optimiseProgram("g");
+	BOOST_TEST(&cachedProgramG.ast() == &m_program.ast());
+
+	Program expectedProgram = optimisedProgram(m_program, "hgu");
+	Program cachedProgram = m_programCache.optimiseProgram("hgu");
+
+	BOOST_TEST(toString(cachedProgram) == toString(expectedProgram));
+	BOOST_TEST(&m_programCache.find("h")->ast() == &m_program.ast());
+	BOOST_TEST(&m_programCache.find("hg")->ast() == &m_program.ast());
+	BOOST_TEST(&m_programCache.find("hgu")->ast() != &m_program.ast());
+}
+
 BOOST_FIXTURE_TEST_CASE(startRound_should_remove_entries_older_than_two_rounds, ProgramCacheFixture)
 {
 	BOOST_TEST(m_programCache.currentRound() == 0);
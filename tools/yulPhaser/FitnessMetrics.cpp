@@ -20,13 +20,58 @@
 
 #include <libsolutil/CommonIO.h>
 
+#include <atomic>
 #include <cmath>
+#include <exception>
+#include <thread>
 
 using namespace std;
 using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::phaser;
 
+vector<size_t> FitnessMetric::evaluateAll(vector<Chromosome> const& _chromosomes)
+{
+	vector<size_t> fitness(_chromosomes.size());
+	size_t const threadCount = min(m_threadCount, _chromosomes.size());
+	if (threadCount <= 1)
+	{
+		for (size_t i = 0; i < _chromosomes.size(); ++i)
+			fitness[i] = evaluate(_chromosomes[i]);
+		return fitness;
+	}
+
+	// Chromosomes are handed out one by one because evaluation times vary a lot.
+	atomic<size_t> nextIndex = 0;
+	vector<exception_ptr> exceptions(threadCount);
+	auto evaluateRemaining = [&](size_t _threadIndex)
+	{
+		try
+		{
+			for (size_t i = nextIndex++; i < _chromosomes.size(); i = nextIndex++)
+				fitness[i] = evaluate(_chromosomes[i]);
+		}
+		catch (...)
+		{
+			exceptions[_threadIndex] = current_exception();
+			nextIndex = _chromosomes.size();
+		}
+	};
+
+	vector<thread> workers;
+	for (size_t threadIndex = 1; threadIndex < threadCount; ++threadIndex)
+		workers.emplace_back(evaluateRemaining, threadIndex);
+	evaluateRemaining(0);
+	for (thread& worker: workers)
+		worker.join();
+
+	for (exception_ptr const& exception: exceptions)
+		if (exception)
+			rethrow_exception(exception);
+
+	return fitness;
+}
+
 Program const& ProgramBasedMetric::program() const
 {
 	if (m_programCache == nullptr)
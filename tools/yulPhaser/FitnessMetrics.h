@@ -29,6 +29,7 @@
 
 #include <cstddef>
 #include <optional>
+#include <vector>
 
 namespace solidity::phaser
 {
@@ -39,6 +40,9 @@ namespace solidity::phaser
  * The main feature is the @a evaluate() method that can tell how good a given chromosome is.
  * The lower the value, the better the fitness is. The result should be deterministic and depend
  * only on the chromosome and metric's state (which is constant).
+ *
+ * @a evaluate() must be safe to call from multiple threads at the same time. @a evaluateAll()
+ * relies on that to evaluate multiple chromosomes in parallel if a thread count above one is set.
  */
 class FitnessMetric
 {
@@ -49,6 +53,16 @@ public:
 	virtual ~FitnessMetric() = default;
 
 	virtual size_t evaluate(Chromosome const& _chromosome) = 0;
+
+	/// Evaluates all the chromosomes using up to @a threadCount() threads.
+	/// Since evaluation is deterministic, the result does not depend on the number of threads.
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes);
+
+	size_t threadCount() const { return m_threadCount; }
+	void setThreadCount(size_t _threadCount) { m_threadCount = _threadCount; }
+
+private:
+	size_t m_threadCount = 1;
 };
 
 /**
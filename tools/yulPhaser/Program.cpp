@@ -61,7 +61,7 @@ ostream& operator<<(ostream& _stream, Program const& _program);
 }
 
 Program::Program(Program const& program):
-	m_ast(make_unique<Block>(get<Block>(ASTCopier{}(*program.m_ast)))),
+	m_ast(program.m_ast),
 	m_dialect{program.m_dialect},
 	m_nameDispenser(program.m_nameDispenser)
 {
@@ -102,7 +102,10 @@ variant<Program, ErrorList> Program::load(CharStream& _sourceCode)
 
 void Program::optimise(vector<string> const& _optimisationSteps)
 {
-	m_ast = applyOptimisationSteps(m_dialect, m_nameDispenser, std::move(m_ast), _optimisationSteps);
+	// Other copies of the program must not see the changes.
+	if (m_ast.use_count() > 1)
+		m_ast = make_shared<Block>(get<Block>(ASTCopier{}(*m_ast)));
+	applyOptimisationSteps(m_dialect, m_nameDispenser, *m_ast, _optimisationSteps);
 }
 
 ostream& phaser::operator<<(ostream& _stream, Program const& _program)
@@ -145,12 +148,9 @@ variant<unique_ptr<Block>, ErrorList> Program::parseObject(Dialect const& _diale
 			}
 	Object* selectedObject = (deployedObject != nullptr ? deployedObject : object.get());
 
-	// NOTE: I'm making a copy of the whole AST to get unique_ptr rather than shared_ptr.
-	// This is a slight performance hit but it's much less than the parsing itself.
-	// unique_ptr lets me be sure that two Program instances can never share the AST by mistake.
-	// The public API of the class does not provide access to the smart pointer so it won't be hard
-	// to switch to shared_ptr if the copying turns out to be an issue (though it would be better
-	// to refactor ObjectParser and Object to use unique_ptr instead).
+	// NOTE: I'm making a copy of the whole AST so that the program does not share it with the parsed
+	// object. This is a slight performance hit but it's much less than the parsing itself.
+	// Program instances only share their ASTs with each other and copy them before modifying them.
 	auto astCopy = make_unique<Block>(get<Block>(ASTCopier{}(*selectedObject->code)));
 
 	return variant<unique_ptr<Block>, ErrorList>(std::move(astCopy));
@@ -183,10 +183,10 @@ unique_ptr<Block> Program::disambiguateAST(
 	return make_unique<Block>(get<Block>(disambiguator(_ast)));
 }
 
-unique_ptr<Block> Program::applyOptimisationSteps(
+void Program::applyOptimisationSteps(
 	Dialect const& _dialect,
 	NameDispenser& _nameDispenser,
-	unique_ptr<Block> _ast,
+	Block& _ast,
 	vector<string> const& _optimisationSteps
 )
 {
@@ -201,9 +201,7 @@ unique_ptr<Block> Program::applyOptimisationSteps(
 	};
 
 	for (string const& step: _optimisationSteps)
-		OptimiserSuite::allSteps().at(step)->run(context, *_ast);
-
-	return _ast;
+		OptimiserSuite::allSteps().at(step)->run(context, _ast);
 }
 
 size_t Program::computeCodeSize(Block const& _ast, CodeWeights const& _weights)
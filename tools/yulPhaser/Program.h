@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <libyul/AST.h>
 
@@ -59,6 +60,9 @@ namespace solidity::phaser
  *
  * The class allows the user to apply extra optimisations and obtain metrics and general
  * information about the resulting syntax tree.
+ *
+ * Copies of a program share the syntax tree until one of them is optimised, which makes
+ * copying a program cheap.
  */
 class Program
 {
@@ -76,6 +80,11 @@ public:
 	void optimise(std::vector<std::string> const& _optimisationSteps);
 
 	size_t codeSize(yul::CodeWeights const& _weights) const { return computeCodeSize(*m_ast, _weights); }
+	/// @returns a hash that is very likely different for programs with different code,
+	/// including code that only differs in names.
+	uint64_t codeHash() const { return yul::CodeHasher::run(*m_ast); }
+	/// @returns the number of names the optimisation steps may not use for new identifiers.
+	size_t usedNameCount() const { return m_nameDispenser.usedNames().size(); }
 	yul::Block const& ast() const { return *m_ast; }
 
 	friend std::ostream& operator<<(std::ostream& _stream, Program const& _program);
@@ -104,15 +113,15 @@ private:
 		yul::Block const& _ast,
 		yul::AsmAnalysisInfo const& _analysisInfo
 	);
-	static std::unique_ptr<yul::Block> applyOptimisationSteps(
+	static void applyOptimisationSteps(
 		yul::Dialect const& _dialect,
 		yul::NameDispenser& _nameDispenser,
-		std::unique_ptr<yul::Block> _ast,
+		yul::Block& _ast,
 		std::vector<std::string> const& _optimisationSteps
 	);
 	static size_t computeCodeSize(yul::Block const& _ast, yul::CodeWeights const& _weights);
 
-	std::unique_ptr<yul::Block> m_ast;
+	std::shared_ptr<yul::Block> m_ast;
 	yul::Dialect const& m_dialect;
 	yul::NameDispenser m_nameDispenser;
 };
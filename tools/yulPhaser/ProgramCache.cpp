@@ -22,6 +22,8 @@
 
 #include <libyul/optimiser/Suite.h>
 
+#include <optional>
+
 using namespace std;
 using namespace solidity::yul;
 using namespace solidity::phaser;
@@ -60,35 +62,68 @@ Program ProgramCache::optimiseProgram(
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
 	size_t prefixSize = 0;
-	for (size_t i = 1; i <= targetOptimisations.size(); ++i)
+	Program const* cachedProgram = &m_program;
+	uint64_t codeHash = m_programCodeHash;
 	{
-		auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
-		if (pair != m_entries.end())
+		lock_guard<mutex> lock(m_mutex);
+		for (size_t i = 1; i <= targetOptimisations.size(); ++i)
 		{
-			pair->second.roundNumber = m_currentRound;
-			++prefixSize;
-			++m_hits;
+			auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
+			if (pair != m_entries.end())
+			{
+				pair->second.roundNumber = m_currentRound;
+				cachedProgram = &pair->second.program;
+				codeHash = pair->second.codeHash;
+				++prefixSize;
+				++m_hits;
+			}
+			else
+				break;
 		}
-		else
-			break;
 	}
 
-	Program intermediateProgram = (
-		prefixSize == 0 ?
-		m_program :
-		m_entries.at(targetOptimisations.substr(0, prefixSize)).program
-	);
+	// Entries are only removed between rounds and never modified after insertion
+	// (other than their round number), so it is safe to copy the program without the lock.
+	// The copy shares the AST with the entry until it is optimised.
+	optional<Program> intermediateProgram{*cachedProgram};
 
 	for (size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
 	{
-		string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
-		intermediateProgram.optimise({stepName});
+		pair<uint64_t, char> step{codeHash, targetOptimisations[i - 1]};
+		bool unchanged = false;
+		{
+			lock_guard<mutex> lock(m_mutex);
+			unchanged = m_unchangingSteps.count(step) > 0;
+		}
+		if (!unchanged)
+		{
+			Program optimisedProgram = *intermediateProgram;
+			optimisedProgram.optimise({OptimiserSuite::stepAbbreviationToNameMap().at(step.second)});
+			uint64_t optimisedCodeHash = optimisedProgram.codeHash();
+			if (
+				optimisedCodeHash == codeHash &&
+				optimisedProgram.usedNameCount() == intermediateProgram->usedNameCount()
+			)
+			{
+				// Keep sharing the AST of the previous program instead of the unchanged copy.
+				lock_guard<mutex> lock(m_mutex);
+				m_unchangingSteps.insert(step);
+			}
+			else
+			{
+				intermediateProgram.emplace(std::move(optimisedProgram));
+				codeHash = optimisedCodeHash;
+			}
+		}
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		pair<string, CacheEntry> entry{targetOptimisations.substr(0, i), {*intermediateProgram, codeHash, m_currentRound}};
+		lock_guard<mutex> lock(m_mutex);
+		// If another thread has inserted the same prefix in the meantime, the programs are identical.
+		m_entries.insert(std::move(entry));
 		++m_misses;
 	}
 
-	return intermediateProgram;
+	return std::move(*intermediateProgram);
 }
 
 void ProgramCache::startRound(size_t _roundNumber)
@@ -110,6 +145,7 @@ void ProgramCache::startRound(size_t _roundNumber)
 void ProgramCache::clear()
 {
 	m_entries.clear();
+	m_unchangingSteps.clear();
 	m_currentRound = 0;
 }
 
@@ -24,7 +24,10 @@
 
 #include <cstddef>
 #include <map>
+#include <mutex>
+#include <set>
 #include <string>
+#include <utility>
 
 namespace solidity::phaser
 {
@@ -36,10 +39,12 @@ namespace solidity::phaser
 struct CacheEntry
 {
 	Program program;
+	uint64_t codeHash;
 	size_t roundNumber;
 
-	CacheEntry(Program _program, size_t _roundNumber):
+	CacheEntry(Program _program, uint64_t _codeHash, size_t _roundNumber):
 		program(std::move(_program)),
+		codeHash(_codeHash),
 		roundNumber(_roundNumber) {}
 };
 
@@ -99,15 +104,27 @@ struct CacheStats
  * experiments) but there's room for improvement. We could fit more useful programs in
  * the cache by being more picky about which ones we choose.
  *
+ * The cache also remembers which steps did not change the code of a program. Such steps are
+ * skipped when they are applied to the same code again and the entries for the longer prefixes
+ * share the syntax tree with the shorter ones. This relies on steps not changing the code being
+ * independent of the names used in other programs, which holds because steps only request new
+ * names when they change the code.
+ *
  * There is currently no way to purge entries without starting a new round. Since the programs
  * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
  * long and programs large. A limiter based on entry count or total program size would be useful.
+ *
+ * @a optimiseProgram() can be called from multiple threads at the same time, which lets parallel
+ * fitness evaluations share their prefixes. All the other functions must not be called while
+ * an optimisation is in progress. Programs for prefixes that are requested by multiple threads
+ * at the same time may be computed more than once, which affects the statistics but not the results.
  */
 class ProgramCache
 {
 public:
 	explicit ProgramCache(Program _program):
-		m_program(std::move(_program)) {}
+		m_program(std::move(_program)),
+		m_programCodeHash(m_program.codeHash()) {}
 
 	Program optimiseProgram(
 		std::string const& _abbreviatedOptimisationSteps,
@@ -136,9 +153,15 @@ private:
 	std::map<std::string, CacheEntry> m_entries;
 
 	Program m_program;
+	uint64_t m_programCodeHash;
+	/// Hashes of code together with the abbreviations of the steps that did not change that code.
+	std::set<std::pair<uint64_t, char>> m_unchangingSteps;
 	size_t m_currentRound = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;
+
+	/// Protects the entries, the unchanging steps and the statistics while programs are being optimised.
+	std::mutex m_mutex;
 };
 
 }